@@ -0,0 +1,21 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Engine benchmarks run by PongBench, each logs its figures and returns the exit code
+
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 1 when a correctness check fails (replays, decoded states, determinism) or a stated budget
+// is missed
+int runParticleBenchmark (std::size_t particles);
+int runPhysicsBenchmark (std::uint64_t ticks);
+int runTelemetryBenchmark (std::uint64_t ticks);
+int runFlightBenchmark (std::uint64_t frames);
+int runTimelineBenchmark (std::size_t timelines);
+int runSpectatorBenchmark (std::size_t spectators, const std::string& endpoint);
+
+#endif // BENCHMARKS_HPP
@@ -0,0 +1,77 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Flight recorder cost per frame and the replay of its recording
+
+#include "Benchmarks.hpp"
+#include "Measure.hpp"
+
+#include "FlightRecorder/FlightRecorder.hpp"
+#include "GameEngine/Simulation.hpp"
+#include "Tournament/Tournament.hpp"
+#include "Logger/Logger.hpp"
+#include "Utils/Utils.hpp"
+
+#include <filesystem>
+#include <system_error>
+
+using namespace Utils;
+
+// Headless tracker games recorded the way the engine records a frame: input, snapshot every
+// snapshotInterval ticks and frame timings. Reports the median recording cost per frame over
+// pairs of runs timed in CPU time, then reads the file back and replays it, which has to
+// match every snapshot.
+int runFlightBenchmark (std::uint64_t frames) {
+  const std::filesystem::path path
+      = std::filesystem::temp_directory_path () / "pong-flight-bench.pfr";
+  FlightRecorder::FlightRecorder recorder;
+  if (!recorder.open (path, 30.0, dotname::Rules{}))
+    return 1;
+  recorder.attachProcess ();
+
+  const Measure::PairedRuns runs = Measure::paired (9, [&] (bool recording) {
+    dotname::Simulation simulation;
+    auto policy = Tournament::findPolicy ("tracker")->create ();
+    policy->reset (7);
+    if (recording)
+      recorder.snapshot (simulation, false);
+    for (std::uint64_t i = 0; i < frames; i++) {
+      const dotname::PaddleInput input = policy->decide (simulation);
+      if (recording)
+        recorder.input (simulation.tick, input, true, false, false);
+      simulation.Step (input);
+      if (simulation.gameOver)
+        simulation.Reset ();
+      if (recording) {
+        if (simulation.tick % FlightRecorder::snapshotInterval == 0 || simulation.tick == 0)
+          recorder.snapshot (simulation, false);
+        FlightRecorder::FrameRecord frame{};
+        frame.frame = i;
+        frame.intervalMs = 8.33f;
+        frame.renderScale = 1.0f;
+        frame.targetFps = 120;
+        recorder.frame (frame);
+      }
+    }
+  });
+  LOG_I_STREAM << "Flight recorder bench finished" << std::endl;
+  recorder.close ();
+
+  FlightRecorder::FlightLog log;
+  const bool readable = FlightRecorder::read (path, log);
+  std::error_code ignored;
+  std::filesystem::remove (path, ignored);
+  if (!readable)
+    return 1;
+  const FlightRecorder::ReplaySummary replay = FlightRecorder::replay (log);
+  const double perFrame = Stats::percentile (runs.differences, 0.5) / frames;
+  LOG_I_FMT ("Flight recorder, {} frames: {:.0f} ns/frame recording ({:.4f}% of a 120 Hz "
+             "frame); {} slots kept, replay of {} steps matched {} of {} snapshots",
+             frames, perFrame * 1e9, perFrame * 120.0 * 100.0, log.records.size (),
+             replay.steps, replay.checked - replay.diverged, replay.checked);
+  if (replay.checked == 0 || replay.diverged > 0 || log.logs.empty ()
+      || log.logs.back ().text != "Flight recorder bench finished") {
+    LOG_E_STREAM << "Flight recording did not replay or lost its last log line" << std::endl;
+    return 1;
+  }
+  return 0;
+}
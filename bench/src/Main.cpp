@@ -0,0 +1,89 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "Benchmarks.hpp"
+
+#include "Logger/Logger.hpp"
+
+#include <cxxopts.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Config {
+
+  constexpr char benchName[] = "PongBench";
+}
+
+int processArguments (int argc, const char* argv[]) {
+  try {
+    auto options = std::make_unique<cxxopts::Options> (argv[0], Config::benchName);
+    options->set_width (80);
+    options->set_tab_expansion ();
+    options->add_options () ("h,help", "Show help");
+    options->add_options ("Benchmarks") (
+        "particles", "Time the particle update for N particles",
+        cxxopts::value<std::size_t> ()->default_value ("100000")->implicit_value ("100000"));
+    options->add_options ("Benchmarks") (
+        "physics", "Compare float and fixed point simulation throughput over N ticks",
+        cxxopts::value<std::uint64_t> ()->default_value ("1000000")->implicit_value ("1000000"));
+    options->add_options ("Benchmarks") (
+        "telemetry", "Measure the event recording overhead on headless games of N ticks",
+        cxxopts::value<std::uint64_t> ()->default_value ("2000000")->implicit_value ("2000000"));
+    options->add_options ("Benchmarks") (
+        "flight", "Measure the flight recorder cost over N frames and replay the recording",
+        cxxopts::value<std::uint64_t> ()->default_value ("200000")->implicit_value ("200000"));
+    options->add_options ("Benchmarks") (
+        "timeline", "Advance N timers and waits at 120 Hz and check their timing",
+        cxxopts::value<std::size_t> ()->default_value ("10000")->implicit_value ("10000"));
+    options->add_options ("Benchmarks") (
+        "spectators", "Stream a headless game to N local spectators",
+        cxxopts::value<std::size_t> ()->default_value ("200")->implicit_value ("200"));
+    options->add_options ("Benchmarks") (
+        "endpoint", "Spectator stream endpoint, a localhost port or unix:<path>",
+        cxxopts::value<std::string> ()->default_value ("9465"));
+    const auto result = options->parse (argc, argv);
+
+    if (result.count ("help")) {
+      LOG_I_STREAM << options->help ({ "", "Benchmarks" }) << std::endl;
+      return 0;
+    }
+    if (!result.unmatched ().empty ()) {
+      for (const auto& arg : result.unmatched ()) {
+        LOG_E_STREAM << "Unrecognized option: " << arg << std::endl;
+      }
+      LOG_I_STREAM << options->help () << std::endl;
+      return 1;
+    }
+
+    // Without a selection every benchmark runs at its default size
+    const bool all = !result.count ("particles") && !result.count ("physics")
+                     && !result.count ("telemetry") && !result.count ("flight")
+                     && !result.count ("timeline") && !result.count ("spectators");
+    int failed = 0;
+    if (all || result.count ("particles"))
+      failed |= runParticleBenchmark (result["particles"].as<std::size_t> ());
+    if (all || result.count ("physics"))
+      failed |= runPhysicsBenchmark (result["physics"].as<std::uint64_t> ());
+    if (all || result.count ("telemetry"))
+      failed |= runTelemetryBenchmark (result["telemetry"].as<std::uint64_t> ());
+    if (all || result.count ("flight"))
+      failed |= runFlightBenchmark (result["flight"].as<std::uint64_t> ());
+    if (all || result.count ("timeline"))
+      failed |= runTimelineBenchmark (result["timeline"].as<std::size_t> ());
+    if (all || result.count ("spectators"))
+      failed |= runSpectatorBenchmark (result["spectators"].as<std::size_t> (),
+                                       result["endpoint"].as<std::string> ());
+    return failed;
+
+  } catch (const cxxopts::exceptions::exception& e) {
+    LOG_E_STREAM << "error parsing options: " << e.what () << std::endl;
+    return 1;
+  }
+}
+
+int main (int argc, const char* argv[]) {
+  LOG_I_STREAM << "Starting " << Config::benchName << " ..." << std::endl;
+  return processArguments (argc, argv) != 0 ? 1 : 0;
+}
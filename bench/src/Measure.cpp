@@ -0,0 +1,32 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Timing shared by the benchmarks: thread CPU time and paired plain/instrumented runs
+
+#include "Measure.hpp"
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <time.h>
+#endif
+
+namespace Measure {
+
+  double threadSeconds () {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes (GetCurrentThread (), &creation, &exit, &kernel, &user))
+      return 0.0;
+    // 100 ns units
+    const auto ticks = [] (const FILETIME& time) {
+      return (static_cast<unsigned long long> (time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    return static_cast<double> (ticks (kernel) + ticks (user)) * 1e-7;
+#else
+    timespec now{};
+    clock_gettime (CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<double> (now.tv_sec) + static_cast<double> (now.tv_nsec) * 1e-9;
+#endif
+  }
+
+} // namespace Measure
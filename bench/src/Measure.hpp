@@ -0,0 +1,58 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Timing shared by the benchmarks: thread CPU time and paired plain/instrumented runs
+
+#ifndef MEASURE_HPP
+#define MEASURE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Measure {
+
+  // CPU time of the calling thread in seconds. Time the thread spends descheduled, which is
+  // most of the run to run noise on a busy machine, does not count, and neither does work
+  // handed to other threads (a telemetry writer, say). Windows counts it in scheduler
+  // quanta of about 16 ms, so time runs much longer than that.
+  double threadSeconds ();
+
+  // Thread CPU seconds of work ()
+  template <typename Work> double time (Work&& work) {
+    const double start = threadSeconds ();
+    work ();
+    return threadSeconds () - start;
+  }
+
+  // Costs of an instrumented run over a plain one, one value per pair, sorted
+  struct PairedRuns {
+    std::vector<double> ratios;      // instrumented / plain
+    std::vector<double> differences; // instrumented - plain, in seconds
+    double plainSeconds = HUGE_VAL;  // fastest run of each kind
+    double instrumentedSeconds = HUGE_VAL;
+  };
+
+  // Runs run (false) and run (true) pairs times each. The two runs of a pair are
+  // neighbours, so frequency and scheduling drift shows up in both of them and cancels in
+  // their ratio and difference; which one goes first alternates, which cancels warm up.
+  template <typename Run> PairedRuns paired (int pairs, Run&& run) {
+    PairedRuns result;
+    for (int pair = 0; pair < pairs; pair++) {
+      const bool plainFirst = pair % 2 == 0;
+      const double first = time ([&] () { run (!plainFirst); });
+      const double second = time ([&] () { run (plainFirst); });
+      const double plain = plainFirst ? first : second;
+      const double instrumented = plainFirst ? second : first;
+      result.ratios.push_back (instrumented / plain);
+      result.differences.push_back (instrumented - plain);
+      result.plainSeconds = std::min (result.plainSeconds, plain);
+      result.instrumentedSeconds = std::min (result.instrumentedSeconds, instrumented);
+    }
+    std::sort (result.ratios.begin (), result.ratios.end ());
+    std::sort (result.differences.begin (), result.differences.end ());
+    return result;
+  }
+
+} // namespace Measure
+
+#endif // MEASURE_HPP
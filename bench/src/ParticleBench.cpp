@@ -0,0 +1,46 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Particle pool update time for a full pool
+
+#include "Benchmarks.hpp"
+
+#include "Effects/Particles.hpp"
+#include "Logger/Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+// Times ParticlePool::update on a full pool, once with every particle alive and once with
+// particles expiring and respawning so the swap remove compaction is exercised too
+int runParticleBenchmark (std::size_t particles) {
+  using Clock = std::chrono::steady_clock;
+  constexpr int iterations = 200;
+  constexpr float dt = 1.0f / 120.0f;
+
+  auto measure = [&] (float lifetime, bool respawn) {
+    Effects::ParticlePool pool (particles);
+    Effects::EmitterSettings settings;
+    settings.lifetime = lifetime;
+    pool.emit (Vector2{ 400, 300 }, static_cast<int> (particles), settings);
+    double seconds = 0.0;
+    for (int i = 0; i < iterations; i++) {
+      if (respawn)
+        pool.emit (Vector2{ 400, 300 }, static_cast<int> (particles - pool.size ()), settings);
+      const auto start = Clock::now ();
+      pool.update (dt);
+      seconds += std::chrono::duration<double> (Clock::now () - start).count ();
+    }
+    return seconds / iterations;
+  };
+
+  const double steady = measure (1e6f, false);
+  const double churn = measure (0.25f, true);
+  LOG_I_FMT ("Particle update, {} particles: {:.3f} ms ({:.2f} ns/particle) all alive, "
+             "{:.3f} ms with expiry and respawn",
+             particles, steady * 1e3, steady * 1e9 / particles, churn * 1e3);
+  if (particles >= 100000 && std::max (steady, churn) >= 1e-3) {
+    LOG_W_STREAM << "Particle update exceeds 1 ms for " << particles << " particles" << std::endl;
+    return 1;
+  }
+  return 0;
+}
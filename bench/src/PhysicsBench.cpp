@@ -0,0 +1,118 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Float and fixed point simulation throughput and the determinism check
+
+#include "Benchmarks.hpp"
+
+#include "GameEngine/Simulation.hpp"
+#include "Tournament/Tournament.hpp"
+#include "Logger/Logger.hpp"
+
+#include <chrono>
+#include <cstring>
+
+namespace PhysicsBench {
+
+  constexpr std::uint64_t defaultTicks = 1000000;
+  // Fixed point state checksum for defaultTicks; every platform must reproduce it exactly
+  constexpr std::uint64_t fixedReference = 0x3a7ba28faf9f8279ull;
+
+  struct Result {
+    double seconds = 0.0;
+    std::uint64_t checksum = 14695981039346656037ull; // FNV-1a over sampled state bits
+    int rallies = 0;
+  };
+
+  std::uint64_t stateBits (float value) {
+    std::uint32_t bits;
+    std::memcpy (&bits, &value, sizeof (bits));
+    return bits;
+  }
+  std::uint64_t stateBits (dotname::Fixed value) {
+    return static_cast<std::uint64_t> (value.raw ());
+  }
+
+  // Ball tracking paddle with seeded serve angles, the same integer driven inputs for every
+  // scalar type and rule source so only the arithmetic differs
+  template <typename Sim> Result run (std::uint64_t ticks) {
+    using Clock = std::chrono::steady_clock;
+    using Scalar = typename Sim::ScalarType;
+    Sim simulation;
+    Tournament::SplitMix64 serves (7);
+    Result result;
+    auto mix = [&] (Scalar value) {
+      result.checksum = (result.checksum ^ stateBits (value)) * 1099511628211ull;
+    };
+
+    const auto start = Clock::now ();
+    for (std::uint64_t i = 0; i < ticks; i++) {
+      const Scalar delta = simulation.ball.position.y - simulation.player.position.y;
+      dotname::PaddleInput input;
+      input.up = delta < Scalar (-2);
+      input.down = delta > Scalar (2);
+      input.launch = !simulation.ball.active;
+
+      const bool served = !simulation.ball.active;
+      simulation.Step (input);
+      if (served && simulation.ball.active)
+        simulation.ball.speed.y = Scalar (static_cast<int> (serves.next () % 9) - 4);
+      if (simulation.gameOver) {
+        result.rallies += simulation.score;
+        simulation.Reset ();
+      }
+      if ((i & 1023) == 0) {
+        mix (simulation.ball.position.x);
+        mix (simulation.ball.position.y);
+        mix (simulation.player.position.y);
+      }
+    }
+    result.seconds = std::chrono::duration<double> (Clock::now () - start).count ();
+    result.rallies += simulation.score;
+    return result;
+  }
+
+  // Best of a few runs, the differences measured here are smaller than the scheduling noise
+  template <typename Sim> Result fastest (std::uint64_t ticks) {
+    Result best = run<Sim> (ticks);
+    for (int repeat = 1; repeat < 5; repeat++) {
+      const Result result = run<Sim> (ticks);
+      if (result.seconds < best.seconds)
+        best = result;
+    }
+    return best;
+  }
+
+} // namespace PhysicsBench
+
+// Float and fixed point simulation throughput with runtime and compile time classic rules,
+// plus the fixed point determinism check
+int runPhysicsBenchmark (std::uint64_t ticks) {
+  const auto floating = PhysicsBench::fastest<dotname::Simulation> (ticks);
+  const auto floatingStatic = PhysicsBench::fastest<dotname::ClassicSimulation> (ticks);
+  const auto fixed = PhysicsBench::fastest<dotname::FixedSimulation> (ticks);
+  const auto fixedStatic = PhysicsBench::fastest<dotname::FixedClassicSimulation> (ticks);
+  LOG_I_FMT ("Physics, {} ticks: float {:.3g} ticks/s ({} paddle hits, state {:016x}), "
+             "fixed {:.3g} ticks/s ({} paddle hits, state {:016x}), fixed/float time {:.2f}x",
+             ticks, ticks / floating.seconds, floating.rallies, floating.checksum,
+             ticks / fixed.seconds, fixed.rallies, fixed.checksum,
+             fixed.seconds / floating.seconds);
+  LOG_I_FMT ("Compile time rules: float {:.3g} ticks/s ({:.2f}x runtime rules), "
+             "fixed {:.3g} ticks/s ({:.2f}x runtime rules)",
+             ticks / floatingStatic.seconds, floating.seconds / floatingStatic.seconds,
+             ticks / fixedStatic.seconds, fixed.seconds / fixedStatic.seconds);
+  if (floatingStatic.checksum != floating.checksum) {
+    // Allowed: folded constants can let the compiler contract float operations differently
+    LOG_W_STREAM << "Float state differs between runtime and compile time rules" << std::endl;
+  }
+  if (fixedStatic.checksum != fixed.checksum) {
+    LOG_E_FMT ("Fixed point state {:016x} with compile time rules differs from {:016x}",
+               fixedStatic.checksum, fixed.checksum);
+    return 1;
+  }
+  if (ticks == PhysicsBench::defaultTicks && fixed.checksum != PhysicsBench::fixedReference) {
+    LOG_E_FMT ("Fixed point state {:016x} differs from the reference {:016x}", fixed.checksum,
+               PhysicsBench::fixedReference);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,163 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Spectator stream size and latency for a headless game and local spectators
+
+#include "Benchmarks.hpp"
+
+#include "GameEngine/Simulation.hpp"
+#include "Spectator/SpectatorServer.hpp"
+#include "Tournament/Tournament.hpp"
+#include "Logger/Logger.hpp"
+#include "Utils/Utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace Utils;
+
+namespace SpectatorBench {
+
+  constexpr std::uint64_t ticks = 1200;
+  constexpr auto tickLength = std::chrono::microseconds (8333);
+  // Bytes per tick with every field at its full width, the baseline for the packed stream
+  constexpr std::size_t unpackedStateBytes = 8 + 8 + 7 * 4 + 2 + 1;
+  constexpr std::size_t unpackedEventBytes = 1 + 2 * 4;
+
+  std::uint64_t nowUs () {
+    return static_cast<std::uint64_t> (std::chrono::duration_cast<std::chrono::microseconds> (
+                                           std::chrono::steady_clock::now ().time_since_epoch ())
+                                           .count ());
+  }
+
+  struct Receiver {
+    std::uint64_t frames = 0;
+    std::uint64_t keyframes = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t mismatches = 0;
+    std::size_t lastIndex = 0;
+    std::vector<double> latencyUs;
+  };
+
+  // Decodes the stream and checks every frame against the published history. The first
+  // frame is a keyframe from somewhere in the history, the rest must follow it tick by tick
+  // (or restart at a later keyframe after a resync).
+  void receive (const std::string& endpoint, const std::vector<Spectator::TickState>& history,
+                const std::atomic<std::size_t>& published, Receiver& receiver) {
+    Spectator::SpectatorClient client;
+    if (!client.connect (endpoint)) {
+      receiver.mismatches++;
+      return;
+    }
+    receiver.latencyUs.reserve (ticks);
+    Spectator::TickState state;
+    bool keyframe = false;
+    std::size_t next = 0;
+    while (client.connected ()) {
+      if (!client.next (state, keyframe, 100))
+        continue;
+      receiver.latencyUs.push_back (static_cast<double> (nowUs () - state.timeUs));
+      receiver.frames++;
+      receiver.keyframes += keyframe ? 1 : 0;
+      const std::size_t count = published.load (std::memory_order_acquire);
+      std::size_t at = next;
+      if (receiver.frames == 1 || (keyframe && (at >= count || history[at] != state))) {
+        while (at < count && history[at] != state)
+          at++;
+      }
+      if (at >= count || history[at] != state) {
+        receiver.mismatches++;
+        continue;
+      }
+      receiver.lastIndex = at;
+      next = at + 1;
+    }
+    receiver.bytes = client.bytesReceived ();
+  }
+
+} // namespace SpectatorBench
+
+// Headless bot game published at 120 Hz to N local spectators, half of them joining halfway
+// through. Checks that every spectator decodes exactly the published states and reports the
+// stream size per tick and the publish to decode latency.
+int runSpectatorBenchmark (std::size_t spectators, const std::string& endpoint) {
+  using Clock = std::chrono::steady_clock;
+  Spectator::SpectatorServer server;
+  if (!server.start (endpoint))
+    return 1;
+
+  std::vector<Spectator::TickState> history (SpectatorBench::ticks);
+  std::atomic<std::size_t> published{ 0 };
+  std::vector<SpectatorBench::Receiver> receivers (spectators);
+  std::vector<std::thread> threads;
+  auto join = [&] (std::size_t from, std::size_t to) {
+    for (std::size_t i = from; i < to; i++)
+      threads.emplace_back (SpectatorBench::receive, std::cref (endpoint), std::cref (history),
+                            std::cref (published), std::ref (receivers[i]));
+  };
+  const std::size_t early = spectators - spectators / 2;
+  join (0, early);
+  std::this_thread::sleep_for (std::chrono::milliseconds (200));
+
+  dotname::Simulation simulation;
+  auto policy = Tournament::findPolicy ("tracker")->create ();
+  policy->reset (1);
+  std::uint64_t events = 0;
+  const auto start = Clock::now ();
+  for (std::size_t i = 0; i < history.size (); i++) {
+    const dotname::GameEvents& tickEvents = simulation.Step (policy->decide (simulation));
+    events += static_cast<std::uint64_t> (tickEvents.count);
+    history[i] = Spectator::capture (simulation, tickEvents, SpectatorBench::nowUs ());
+    published.store (i + 1, std::memory_order_release);
+    server.publish (history[i]);
+    if (simulation.gameOver)
+      simulation.Reset ();
+    if (i == history.size () / 2)
+      join (early, spectators);
+    std::this_thread::sleep_until (start + SpectatorBench::tickLength * (i + 1));
+  }
+  // Let the last frames reach everyone before hanging up
+  std::this_thread::sleep_for (std::chrono::milliseconds (300));
+  const Spectator::SpectatorStats stats = server.stats ();
+  server.stop ();
+  for (std::thread& thread : threads)
+    thread.join ();
+
+  std::vector<double> latencies;
+  std::uint64_t frames = 0;
+  std::uint64_t bytes = 0;
+  std::uint64_t mismatches = 0;
+  std::size_t incomplete = 0;
+  for (const SpectatorBench::Receiver& receiver : receivers) {
+    latencies.insert (latencies.end (), receiver.latencyUs.begin (), receiver.latencyUs.end ());
+    frames += receiver.frames;
+    bytes += receiver.bytes;
+    mismatches += receiver.mismatches;
+    incomplete += receiver.frames == 0 || receiver.lastIndex + 1 != history.size () ? 1 : 0;
+  }
+  std::sort (latencies.begin (), latencies.end ());
+
+  const double ticks = static_cast<double> (history.size ());
+  LOG_I_FMT ("Spectator stream, {} ticks to {} spectators: {:.2f} bytes/tick published "
+             "({:.1f} unpacked, {} keyframes), {:.2f} bytes/frame received, {} bytes sent",
+             history.size (), spectators, stats.bytesPublished / ticks,
+             SpectatorBench::unpackedStateBytes
+                 + SpectatorBench::unpackedEventBytes * static_cast<double> (events) / ticks,
+             stats.keyframes, frames > 0 ? static_cast<double> (bytes) / frames : 0.0,
+             stats.bytesSent);
+  LOG_I_FMT ("Publish to decode latency over {} frames: p50 {:.0f} us, p95 {:.0f} us, "
+             "p99 {:.0f} us, max {:.0f} us; {} resyncs, {} dropped",
+             latencies.size (), Stats::percentile (latencies, 0.5),
+             Stats::percentile (latencies, 0.95), Stats::percentile (latencies, 0.99),
+             latencies.empty () ? 0.0 : latencies.back (), stats.resyncs, stats.dropped);
+  if (mismatches > 0 || incomplete > 0) {
+    LOG_E_FMT ("{} frames decoded to states that were not published, {} spectators did not "
+               "reach the last tick",
+               mismatches, incomplete);
+    return 1;
+  }
+  return 0;
+}
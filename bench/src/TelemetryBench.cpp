@@ -0,0 +1,94 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Cost of gameplay event recording on the game thread
+
+#include "Benchmarks.hpp"
+#include "Measure.hpp"
+
+#include "GameEngine/Simulation.hpp"
+#include "Telemetry/Telemetry.hpp"
+#include "Tournament/Tournament.hpp"
+#include "Logger/Logger.hpp"
+#include "Utils/Utils.hpp"
+
+#include <filesystem>
+#include <system_error>
+
+using namespace Utils;
+
+// Headless tracker games with and without event recording on the tournament's game loop, as
+// pairs of runs timed in game thread CPU time. Fails when the recorded events do not read
+// back, or when the game thread overhead is 2% or more in the 25th percentile of the pairs:
+// noise only ever adds to one run of a pair, the lower quartile is what recording costs.
+int runTelemetryBenchmark (std::uint64_t ticks) {
+  const std::filesystem::path path
+      = std::filesystem::temp_directory_path () / "pong-telemetry-bench.pev";
+  Telemetry::TelemetryWriter writer;
+  if (!writer.open (path))
+    return 1;
+
+  Measure::PairedRuns runs;
+  {
+    Telemetry::TelemetryRecorder recorder (writer);
+    runs = Measure::paired (21, [&] (bool recording) {
+      dotname::Simulation simulation;
+      auto policy = Tournament::findPolicy ("tracker")->create ();
+      policy->reset (7);
+      Tournament::SplitMix64 serves (7);
+      std::uint64_t game = 0;
+      for (std::uint64_t i = 0; i < ticks; i++) {
+        const dotname::PaddleInput input = policy->decide (simulation);
+        const bool served = !simulation.ball.active;
+        const dotname::GameEvents& events = simulation.Step (input);
+        if (recording)
+          recorder.record (game, simulation, events);
+        if (served && simulation.ball.active)
+          simulation.ball.speed.y = serves.uniform (-4.0f, 4.0f);
+        if (simulation.gameOver) {
+          simulation.Reset ();
+          game++;
+        }
+      }
+    });
+  }
+  writer.close ();
+  const Telemetry::WriterStats stats = writer.stats ();
+
+  Telemetry::TelemetryReader reader;
+  Telemetry::EventColumns columns;
+  std::uint64_t rowsRead = 0;
+  if (reader.open (path)) {
+    while (reader.next (columns))
+      rowsRead += columns.rows;
+  }
+  std::error_code ignored;
+  std::filesystem::remove (path, ignored);
+
+  constexpr double maxOverhead = 0.02;
+  const double overhead = Stats::percentile (runs.ratios, 0.25) - 1.0;
+  // The writer thread's share, against the game thread time of the recorded runs
+  const double encodeSeconds = static_cast<double> (stats.encodeNanoseconds) * 1e-9;
+  const double recordedSeconds
+      = runs.instrumentedSeconds * static_cast<double> (runs.ratios.size ());
+  LOG_I_FMT ("Telemetry, {} ticks: {:.3g} ticks/s plain, {:.3g} ticks/s recording "
+             "({:+.2f}% overhead, p25 to p75 of {} pairs {:+.2f}% to {:+.2f}%); writer thread "
+             "{:.0f} ns/event encoding ({:.2f}% of the game thread time); {} events in {} "
+             "chunks, {:.2f} bytes/event, {} stalls",
+             ticks, ticks / runs.plainSeconds, ticks / runs.instrumentedSeconds,
+             (Stats::percentile (runs.ratios, 0.5) - 1.0) * 100.0, runs.ratios.size (),
+             overhead * 100.0, (Stats::percentile (runs.ratios, 0.75) - 1.0) * 100.0,
+             stats.rows > 0 ? encodeSeconds * 1e9 / stats.rows : 0.0,
+             recordedSeconds > 0.0 ? encodeSeconds / recordedSeconds * 100.0 : 0.0, stats.rows,
+             stats.chunks, stats.rows > 0 ? static_cast<double> (stats.bytes) / stats.rows : 0.0,
+             stats.stalls);
+  if (reader.failed () || rowsRead != stats.rows) {
+    LOG_E_FMT ("Read back {} of {} telemetry events", rowsRead, stats.rows);
+    return 1;
+  }
+  if (overhead >= maxOverhead) {
+    LOG_E_FMT ("Recording costs {:+.2f}% on the game thread, the budget is {:.0f}%",
+               overhead * 100.0, maxOverhead * 100.0);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,87 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Timeline scheduler cost per frame and timing accuracy
+
+#include "Benchmarks.hpp"
+
+#include "Timeline/Timeline.hpp"
+#include "Logger/Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// Timelines advanced at 120 Hz for a simulated minute: timers from 50 ms to 10 s restarted
+// as they fire, and some waiting on a flag that flips every second. Then the same again with
+// ten times as many timelines asleep for an hour: they are never touched, they only make the
+// timer heap deeper. Fails when a wait fires a frame late or the two runs differ.
+int runTimelineBenchmark (std::size_t timelines) {
+  using Clock = std::chrono::steady_clock;
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  const Timeline::Duration frame = std::chrono::microseconds (8333);
+  const int frames = 120 * 60;
+
+  struct Run {
+    double seconds = 0.0;
+    std::uint64_t actions = 0;
+    Timeline::Duration latest{};
+    Timeline::SchedulerStats stats;
+  };
+  auto measure = [&] (std::size_t sleepers) {
+    Run run;
+    bool flag = false;
+    std::vector<Timeline::Duration> due (timelines);
+    std::vector<std::shared_ptr<const Timeline::Sequence>> sequences;
+    Timeline::Scheduler scheduler; // destroyed first, its actions use the locals above
+
+    auto restart = [&] (std::uint64_t tag) {
+      run.actions++;
+      scheduler.start (sequences[tag % sequences.size ()], tag);
+    };
+    for (int milliseconds : { 50, 100, 250, 500, 1000, 2000, 5000, 10000 }) {
+      const Timeline::Duration wait = std::chrono::milliseconds (milliseconds);
+      auto timer = std::make_shared<Timeline::Sequence> ();
+      timer->call ([&, wait] (std::uint64_t tag) { due[tag] = scheduler.now () + wait; })
+          .wait (wait)
+          .call ([&] (std::uint64_t tag) {
+            run.latest = std::max (run.latest, scheduler.now () - due[tag]);
+            restart (tag);
+          });
+      sequences.push_back (timer);
+    }
+    auto polling = std::make_shared<Timeline::Sequence> ();
+    polling->wait (frame).waitUntil ([&] (std::uint64_t) { return flag; }).call (restart);
+    sequences.push_back (polling);
+
+    for (std::size_t tag = 0; tag < timelines; tag++)
+      scheduler.start (sequences[tag % sequences.size ()], tag);
+    auto sleeper = std::make_shared<Timeline::Sequence> ();
+    sleeper->wait (std::chrono::hours (1)).call ([] (std::uint64_t) {});
+    for (std::size_t i = 0; i < sleepers; i++)
+      scheduler.start (sleeper);
+
+    const auto start = Clock::now ();
+    for (int i = 0; i < frames; i++) {
+      flag = i / 120 % 2 == 1;
+      scheduler.advance (frame);
+    }
+    run.seconds = std::chrono::duration<double> (Clock::now () - start).count ();
+    run.stats = scheduler.stats ();
+    return run;
+  };
+
+  const Run active = measure (0);
+  const Run crowded = measure (timelines * 10);
+  LOG_I_FMT ("Timelines: {} at 120 Hz for 60 s, {} actions: {:.0f} ns/frame, {:.1f} ns per "
+             "action; with {} more asleep: {:.0f} ns/frame; waits fired at most {:.2f} ms late",
+             timelines, active.actions, active.seconds / frames * 1e9,
+             active.actions > 0 ? active.seconds / active.actions * 1e9 : 0.0,
+             crowded.stats.sleeping - active.stats.sleeping, crowded.seconds / frames * 1e9,
+             Milliseconds (active.latest).count ());
+  if (active.actions == 0 || active.actions != crowded.actions || active.latest >= frame) {
+    LOG_E_STREAM << "Timelines fired late or differently with sleepers around" << std::endl;
+    return 1;
+  }
+  return 0;
+}
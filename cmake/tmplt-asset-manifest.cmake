@@ -0,0 +1,36 @@
+# MIT License Copyright (c) 2024-2025 Tomáš Mark
+
+# Script mode helper (cmake -P) run at build time by tmplt-assets.cmake. It writes the asset
+# manifest: one line per asset with the content hash (first 64 bits of SHA256 as 16 hex digits),
+# the size in bytes and the file name relative to the assets directory, separated by tabs.
+#
+# Required variables: ASSET_SOURCE_DIR, ASSET_MANIFEST_FILE
+
+cmake_minimum_required(VERSION 3.14 FATAL_ERROR)
+
+if(NOT ASSET_SOURCE_DIR OR NOT ASSET_MANIFEST_FILE)
+    message(FATAL_ERROR "ASSET_SOURCE_DIR and ASSET_MANIFEST_FILE must be set")
+endif()
+
+file(
+    GLOB_RECURSE ASSET_FILES
+    RELATIVE "${ASSET_SOURCE_DIR}"
+    "${ASSET_SOURCE_DIR}/*")
+list(SORT ASSET_FILES)
+
+set(MANIFEST_CONTENT "# PongGame asset manifest v1\n")
+foreach(ASSET_FILE ${ASSET_FILES})
+    file(SIZE "${ASSET_SOURCE_DIR}/${ASSET_FILE}" ASSET_SIZE)
+    file(SHA256 "${ASSET_SOURCE_DIR}/${ASSET_FILE}" ASSET_SHA256)
+    string(SUBSTRING "${ASSET_SHA256}" 0 16 ASSET_HASH)
+    string(APPEND MANIFEST_CONTENT "${ASSET_HASH}\t${ASSET_SIZE}\t${ASSET_FILE}\n")
+endforeach()
+
+# Only touch the file when something changed so incremental builds stay quiet
+if(EXISTS "${ASSET_MANIFEST_FILE}")
+    file(READ "${ASSET_MANIFEST_FILE}" OLD_MANIFEST_CONTENT)
+    if(OLD_MANIFEST_CONTENT STREQUAL MANIFEST_CONTENT)
+        return()
+    endif()
+endif()
+file(WRITE "${ASSET_MANIFEST_FILE}" "${MANIFEST_CONTENT}")
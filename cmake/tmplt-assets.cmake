@@ -3,6 +3,10 @@
 # This CMake script will copy and install assets for the standalone application. The assets are
 # copied from the source directory to the build directory and installed to the installation
 # directory. The asset paths are defined as compilation definitions for the standalone application.
+# A content-addressed manifest (see tmplt-asset-manifest.cmake) is generated at build time and
+# shipped next to the assets, so the runtime can look assets up without scanning the directory.
+
+set(TMPLT_ASSETS_LIST_DIR "${CMAKE_CURRENT_LIST_DIR}")
 
 function(copy_assets target asset_sources destination)
     add_custom_command(
@@ -12,6 +16,27 @@ function(copy_assets target asset_sources destination)
         COMMAND ${CMAKE_COMMAND} -E copy_directory ${asset_sources} "${destination}")
 endfunction()
 
+function(generate_asset_manifest target asset_sources asset_files destination)
+    set(ASSET_MANIFEST_FILE "${CMAKE_CURRENT_BINARY_DIR}/assets.manifest")
+    add_custom_command(
+        OUTPUT "${ASSET_MANIFEST_FILE}"
+        COMMAND ${CMAKE_COMMAND} -DASSET_SOURCE_DIR=${asset_sources}
+                -DASSET_MANIFEST_FILE=${ASSET_MANIFEST_FILE} -P
+                ${TMPLT_ASSETS_LIST_DIR}/tmplt-asset-manifest.cmake
+        DEPENDS ${asset_files} ${TMPLT_ASSETS_LIST_DIR}/tmplt-asset-manifest.cmake
+        COMMENT "Generating asset manifest")
+    add_custom_target(asset-manifest-${target} DEPENDS "${ASSET_MANIFEST_FILE}")
+    add_dependencies(${target} asset-manifest-${target})
+    # runs after copy_assets, both are POST_BUILD steps of the same target
+    add_custom_command(
+        TARGET ${target}
+        POST_BUILD
+        COMMAND ${CMAKE_COMMAND} -E copy_if_different "${ASSET_MANIFEST_FILE}" "${destination}")
+    set(ASSET_MANIFEST_FILE
+        "${ASSET_MANIFEST_FILE}"
+        PARENT_SCOPE)
+endfunction()
+
 function(apply_assets_processing_standalone)
 
     # Source destination
@@ -59,6 +84,11 @@ function(apply_assets_processing_standalone)
     copy_assets(${STANDALONE_NAME} "${ASSET_SOURCE_DIR}" "${ASSET_BUILD_DIR}")
     install(DIRECTORY ${ASSET_SOURCE_DIR} DESTINATION ${INSTALL_DESTINATION})
 
+    # Build time manifest (name, size, content hash) next to the assets
+    generate_asset_manifest(${STANDALONE_NAME} "${ASSET_SOURCE_DIR}" "${ASSET_FILES}"
+                            "${ASSET_BUILD_DIR}")
+    install(FILES "${ASSET_MANIFEST_FILE}" DESTINATION ${INSTALL_DESTINATION})
+
     # Set compilation definitions for asset paths
     target_compile_definitions(
         ${STANDALONE_NAME}
@@ -0,0 +1,56 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef __ENGINEGROUP_HPP
+#define __ENGINEGROUP_HPP
+
+#include <GameEngine/GameEngine.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace Timing {
+  class FramePacer;
+}
+
+namespace dotname {
+
+  // Drives initialized engines sharing one window, for split screen or multi cabinet boards.
+  // Each frame the keyboard is read once for all of them, every engine updates and renders
+  // into its own target, and the targets are presented side by side in a grid within one
+  // BeginDrawing/EndDrawing. One frame pacer serves the group: it idles only when every
+  // engine is idle. A single engine fills the window.
+  class EngineGroup {
+  public:
+    // Frame rate cap, power budget and idle throttling come from the pacing fields of config
+    explicit EngineGroup (const EngineConfig& config = {});
+    ~EngineGroup ();
+
+    EngineGroup (const EngineGroup&) = delete;
+    EngineGroup& operator= (const EngineGroup&) = delete;
+
+    // The engine must be initialized and outlive the group
+    void add (GameEngine& engine);
+    std::size_t size () const {
+      return engines_.size ();
+    }
+
+    // One frame of every engine; returns false once the window was asked to close
+    bool tick ();
+    // Sizes the window for the grid, ticks until it is closed and logs the pacing summary
+    void run ();
+
+    // Tile of the window for engine index, in window pixels
+    Rectangle tile (std::size_t index) const;
+
+  private:
+    std::vector<GameEngine*> engines_;
+    std::unique_ptr<Timing::FramePacer> pacer_;
+    std::chrono::steady_clock::time_point lastFrameStart_{};
+    bool started_ = false;
+  };
+
+} // namespace dotname
+
+#endif // __ENGINEGROUP_HPP
@@ -0,0 +1,164 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef __FIXEDPOINT_HPP
+#define __FIXEDPOINT_HPP
+
+#include <cmath>
+#include <cstdint>
+
+#include <raylib.h>
+
+// Deterministic fixed point scalar for the simulation. Only integer arithmetic with defined
+// rounding is used, so results are bit identical on every compiler, flag set and CPU.
+
+namespace dotname {
+
+  // Signed Q47.16 in 64 bits: the court (hundreds of pixels) squared still fits comfortably
+  class Fixed {
+  public:
+    static constexpr int fractionBits = 16;
+    static constexpr std::int64_t one = std::int64_t (1) << fractionBits;
+
+    constexpr Fixed () = default;
+    constexpr explicit Fixed (int value) : raw_ (value * one) {
+    }
+
+    static constexpr Fixed fromRaw (std::int64_t raw) {
+      Fixed value;
+      value.raw_ = raw;
+      return value;
+    }
+    // Exact for inputs with up to 16 fractional bits (paddle input fractions, serve angles)
+    static Fixed fromFloat (float value) {
+      return fromRaw (std::llround (static_cast<double> (value) * one));
+    }
+    float toFloat () const {
+      return static_cast<float> (static_cast<double> (raw_) / one);
+    }
+    constexpr std::int64_t raw () const {
+      return raw_;
+    }
+
+    // Products and quotients truncate toward zero (integer division), never via shifts of
+    // negative values, whose rounding is implementation defined before C++20
+    friend constexpr Fixed operator+ (Fixed a, Fixed b) {
+      return fromRaw (a.raw_ + b.raw_);
+    }
+    friend constexpr Fixed operator- (Fixed a, Fixed b) {
+      return fromRaw (a.raw_ - b.raw_);
+    }
+    friend constexpr Fixed operator- (Fixed a) {
+      return fromRaw (-a.raw_);
+    }
+    friend constexpr Fixed operator* (Fixed a, Fixed b) {
+      return fromRaw (a.raw_ * b.raw_ / one);
+    }
+    friend constexpr Fixed operator/ (Fixed a, Fixed b) {
+      return fromRaw (a.raw_ * one / b.raw_);
+    }
+    Fixed& operator+= (Fixed other) {
+      return *this = *this + other;
+    }
+    Fixed& operator-= (Fixed other) {
+      return *this = *this - other;
+    }
+    Fixed& operator*= (Fixed other) {
+      return *this = *this * other;
+    }
+    Fixed& operator/= (Fixed other) {
+      return *this = *this / other;
+    }
+
+    friend constexpr bool operator== (Fixed a, Fixed b) {
+      return a.raw_ == b.raw_;
+    }
+    friend constexpr bool operator!= (Fixed a, Fixed b) {
+      return a.raw_ != b.raw_;
+    }
+    friend constexpr bool operator< (Fixed a, Fixed b) {
+      return a.raw_ < b.raw_;
+    }
+    friend constexpr bool operator<= (Fixed a, Fixed b) {
+      return a.raw_ <= b.raw_;
+    }
+    friend constexpr bool operator> (Fixed a, Fixed b) {
+      return a.raw_ > b.raw_;
+    }
+    friend constexpr bool operator>= (Fixed a, Fixed b) {
+      return a.raw_ >= b.raw_;
+    }
+
+  private:
+    std::int64_t raw_ = 0;
+  };
+
+  // Square root rounded down, bit by bit on the integer representation
+  inline Fixed sqrt (Fixed value) {
+    if (value.raw () <= 0)
+      return Fixed ();
+    std::uint64_t remainder = static_cast<std::uint64_t> (value.raw ()) << Fixed::fractionBits;
+    std::uint64_t root = 0;
+    std::uint64_t bit = std::uint64_t (1) << 62;
+    while (bit > remainder) {
+      bit >>= 2;
+    }
+    while (bit != 0) {
+      if (remainder >= root + bit) {
+        remainder -= root + bit;
+        root = (root >> 1) + bit;
+      } else {
+        root >>= 1;
+      }
+      bit >>= 2;
+    }
+    return Fixed::fromRaw (static_cast<std::int64_t> (root));
+  }
+
+  struct FixedVector2 {
+    Fixed x;
+    Fixed y;
+  };
+
+  struct FixedRectangle {
+    Fixed x;
+    Fixed y;
+    Fixed width;
+    Fixed height;
+  };
+
+  // Vector and rectangle types plus the operations that differ per scalar, so the same
+  // simulation and collision code compiles for float and Fixed
+  template <typename Scalar> struct ScalarTraits;
+
+  template <> struct ScalarTraits<float> {
+    using Vector = Vector2;
+    using Rect = Rectangle;
+    static float sqrt (float value) {
+      return std::sqrt (value);
+    }
+    static float fromFloat (float value) {
+      return value;
+    }
+    static Vector2 toVector2 (Vector2 value) {
+      return value;
+    }
+  };
+
+  template <> struct ScalarTraits<Fixed> {
+    using Vector = FixedVector2;
+    using Rect = FixedRectangle;
+    static Fixed sqrt (Fixed value) {
+      return dotname::sqrt (value);
+    }
+    static Fixed fromFloat (float value) {
+      return Fixed::fromFloat (value);
+    }
+    static Vector2 toVector2 (FixedVector2 value) {
+      return Vector2{ value.x.toFloat (), value.y.toFloat () };
+    }
+  };
+
+} // namespace dotname
+
+#endif // __FIXEDPOINT_HPP
@@ -4,8 +4,14 @@
 #ifndef __GAMEENGINE_HPP
 #define __GAMEENGINE_HPP
 
+#include <GameEngine/Simulation.hpp>
 #include <GameEngine/version.h>
+#include <chrono>
+#include <cstddef>
 #include <filesystem>
+#include <cstdint>
+#include <memory>
+#include <random>
 #include <string>
 
 #include <raylib.h>
@@ -14,60 +20,212 @@
 
 // Public API
 
-#define PLAYER_MAX_LIFE 5
+#define PLAYER_MAX_LIFE (dotname::Rules{}.maxLife)
 #define LINES_OF_BRICKS 5
 #define BRICKS_PER_LINE 20
 
+namespace Audio {
+  class SampleBank;
+}
+namespace Assets {
+  class AssetIndex;
+  class DecodedAssetCache;
+}
+namespace Memory {
+  class FrameArena;
+}
+namespace Input {
+  class InputPipeline;
+  struct LatencySummary;
+  struct PressedKeys;
+}
+namespace Effects {
+  class ParticlePool;
+}
+namespace Timing {
+  struct PacingStats;
+}
+namespace Render {
+  class DrawList;
+  class ResolutionScaler;
+}
+namespace Metrics {
+  struct EngineMetrics;
+  class MetricsServer;
+}
+namespace Spectator {
+  class SpectatorServer;
+}
+namespace Telemetry {
+  class TelemetryWriter;
+  class TelemetryRecorder;
+}
+namespace FlightRecorder {
+  class FlightRecorder;
+}
+namespace Timeline {
+  class Scheduler;
+  class Sequence;
+}
+namespace Runtime {
+  class Platform;
+  class ResourceBank;
+}
+
 namespace dotname {
 
+  // Startup options, applied before the window and audio device are opened
+  struct EngineConfig {
+    // Keep note samples IMA-ADPCM compressed in memory and decode them in the mixer
+    bool compressedSamples = false;
+    // Persistent cache of processed assets keyed by content hash; empty disables it
+    std::filesystem::path cacheDirectory;
+    // Log heap allocations per frame (needs the ENABLE_ALLOCATION_TRACKING build option)
+    bool reportAllocations = false;
+    // Prometheus exporter: a localhost TCP port ("9464") or "unix:<path>"; empty disables it
+    std::string metricsEndpoint;
+    // Spectator stream of the game state per tick, same endpoint forms; empty disables it
+    std::string spectatorEndpoint;
+    // Columnar file of the gameplay events of every game played; empty disables it
+    std::filesystem::path telemetryPath;
+    // File holding the last seconds of inputs, state snapshots, frame timings and log lines,
+    // readable after a crash (--flight-decode); empty disables it
+    std::filesystem::path flightRecorderPath;
+    double flightRecorderSeconds = 30.0;
+    // Extra animated shapes drawn behind the game to load the batched renderer
+    int stressEntities = 0;
+    // Frame pacing: rate cap, share of one core the frame work may use, and event driven
+    // redraw while the screen is static (paused or game over)
+    int targetFps = 120;
+    double powerBudget = 1.0;
+    bool idleThrottle = true;
+    // Internal render resolution as a share of the window: 0 scales it between
+    // minRenderScale and 1 to hold the frame rate, a positive value fixes it
+    float renderScale = 0.0f;
+    float minRenderScale = 0.5f;
+    // W/S, D, Q and E instead of arrows, space, P and enter, for a second player
+    bool wasdKeys = false;
+  };
+
   class GameEngine {
 
     //----------------------------------------------------------------------------------
     // Types and Structures Definition
     //----------------------------------------------------------------------------------
-    typedef struct Player {
-      Vector2 position;
-      Vector2 size;
-      int life;
-    } Player;
-
-    typedef struct Ball {
-      Vector2 position;
-      Vector2 speed;
-      int radius;
-      bool active;
-    } Ball;
-
     typedef struct Brick {
       Vector2 position;
       bool active;
     } Brick;
 
-    typedef struct AudioSample {
-      Sound sound;
-      bool loaded;
-    } AudioSample;
-
     const std::string libName_ = std::string ("GameEngine v.") + GAMEENGINE_VERSION;
     std::filesystem::path assetsPath_;
+    EngineConfig config_;
+    // Window, audio device and note bank, shared with every other engine in the process
+    std::shared_ptr<Runtime::Platform> platform_;
+    std::shared_ptr<Runtime::ResourceBank> bank_;
+    std::unique_ptr<Memory::FrameArena> frameArena_;
+    std::mt19937 random_;
+
+    // Allocation tracking for the frame path
+    std::uint64_t frameAllocations_ = 0;
+    std::uint64_t windowFrames_ = 0;
+    std::uint64_t windowAllocatingFrames_ = 0;
+    std::uint64_t windowAllocations_ = 0;
+    std::uint64_t windowWorstFrame_ = 0;
+    std::uint64_t pendingAllocations_ = 0; // made by this engine's steps of the current frame
+    void TrackFrameAllocations (std::uint64_t allocations);
+
+    // Live counters, scraped from another thread when metricsEndpoint is set
+    std::unique_ptr<Metrics::EngineMetrics> metrics_;
+    std::unique_ptr<Metrics::MetricsServer> metricsServer_;
+    std::chrono::steady_clock::time_point lastFrameStart_;
+    std::chrono::steady_clock::duration frameLength_ = std::chrono::microseconds (8333);
+    // Start of the next simulation tick; ticks run at ticksPerSecond, any number per frame
+    std::chrono::steady_clock::time_point nextTick_;
+    std::chrono::steady_clock::time_point lastSubmit_;
+    std::chrono::steady_clock::duration drawLength_{};
+    void RecordEvents (const GameEvents& events);
+
+    // Game state sent to spectators after every simulation step, when spectatorEndpoint is set
+    std::unique_ptr<Spectator::SpectatorServer> spectator_;
+    void PublishState (const GameEvents& events);
+
+    // Gameplay events for offline analysis, numbered by game since Init
+    std::unique_ptr<Telemetry::TelemetryWriter> telemetryWriter_;
+    std::unique_ptr<Telemetry::TelemetryRecorder> telemetry_;
+    std::uint64_t game_ = 0;
+
+    // Recent history for post mortem replay, when flightRecorderPath is set
+    std::unique_ptr<FlightRecorder::FlightRecorder> flightRecorder_;
+    std::chrono::steady_clock::duration updateLength_{};
+
+    // Timestamped keyboard events, consumed once per frame
+    std::unique_ptr<Input::InputPipeline> input_;
+
+    // Shapes and text recorded by DrawGame and submitted in batches
+    std::unique_ptr<Render::DrawList> drawList_;
+    void DrawStressEntities (void);
+
+    // Offscreen target the game is drawn into in court units, upscaled to the window
+    std::unique_ptr<Render::ResolutionScaler> scaler_;
+
+    // Visual feedback for bounces, paddle hits and lost balls
+    std::unique_ptr<Effects::ParticlePool> particles_;
+    void SpawnEventEffects (const GameEvents& events);
+
+    // Timed sequences (note progressions), advanced by the frame time in Update
+    std::unique_ptr<Timeline::Scheduler> timeline_;
+    std::shared_ptr<const Timeline::Sequence> progressionCDur_;
+    std::shared_ptr<const Timeline::Sequence> progressionCMinor_;
+    std::shared_ptr<const Timeline::Sequence> progressionCMinorReversed_;
+    std::shared_ptr<const Timeline::Sequence> Arpeggio (const std::vector<int>& notes);
 
   public:
-    const int screenWidth = 800;
-    const int screenHeight = 600;
-    bool gameOver = false;
+    // Game constants; the window opens at the court size and can be resized. The simulation
+    // has the classic rules compiled in, so the step code folds them.
+    const Rules rules = ClassicRuleSet::value;
+    const int screenWidth = rules.courtWidth;
+    const int screenHeight = rules.courtHeight;
     bool pause = false;
-    Player player = { { 0, 0 }, { 0, 0 }, 0 };
-    Ball ball = { { 0, 0 }, { 0, 0 }, 0, false };
+    // Player, ball, score and game over state
+    ClassicSimulation simulation;
     Brick brick[LINES_OF_BRICKS][BRICKS_PER_LINE] = {};
     Vector2 brickSize = { 0, 0 };
-    int score = 0;
-    std::vector<AudioSample> notes;
 
   public:
     GameEngine ();
-    GameEngine (const std::filesystem::path& assetsPath);
+    // Init (), then plays in its own window until it is closed, then Shutdown ()
+    GameEngine (const std::filesystem::path& assetsPath, const EngineConfig& config = {});
     ~GameEngine ();
 
+    GameEngine (const GameEngine&) = delete;
+    GameEngine& operator= (const GameEngine&) = delete;
+
+    // Opens the window, audio device and note bank, or joins them when another engine in the
+    // process already did. Returns false when assetsPath is empty.
+    bool Init (const std::filesystem::path& assetsPath, const EngineConfig& config = {});
+    // Releases this engine's share; the last engine closes the window and audio device
+    void Shutdown (void);
+    bool IsInitialized () const {
+      return platform_ != nullptr;
+    }
+
+    // One frame in steps, so a host can run several engines per window frame (EngineGroup).
+    // Update: input and simulation. Render: draws into this engine's render target.
+    // Present: upscales it into area, between BeginDrawing () and EndDrawing ().
+    // FrameDone: after EndDrawing (), with the pacing that governed the frame.
+    void Update (const Input::PressedKeys& pressed);
+    void Render (void);
+    void Present (Rectangle area);
+    void FrameDone (const Timing::PacingStats& pacing);
+    // Paused or game over with no timeline running: nothing changes until input
+    bool IsIdle () const;
+
+    // Sequences started here run from Update; actions run on the game thread
+    Timeline::Scheduler& GetTimeline () {
+      return *timeline_;
+    }
+
     const std::filesystem::path getAssetsPath () const {
       return assetsPath_;
     }
@@ -76,17 +234,29 @@ namespace dotname {
     }
 
     void InitGame (void);
-    void UpdateGame (void);
+    void UpdateGame (const Input::PressedKeys& pressed);
+    void PlayEventSounds (const GameEvents& events);
     void DrawGame (void);
     void UnloadGame (void);
+    // Every step of one frame for an engine that has the window to itself, without pacing
     void UpdateDrawFrame (void);
     void PlayRandomNote ();
     void PlayCDur ();
+    // Start the progression and return; the notes follow on later frames
     void PlayProgressionCDur ();
     void PlayProgressionCMinor ();
     void PlayProgressionCMinorReversed ();
     void PlayRandomNoteInCMinorProgression ();
-    void InitNotes (std::vector<AudioSample>& notes);
+    void InitNotes ();
+    void PlayNote (std::size_t index);
+    // Bytes held by the loaded note samples (decoded PCM or compressed)
+    std::size_t GetAudioResidentBytes () const;
+    // Key poll to frame submit latency over the recent input (see Input::InputPipeline)
+    Input::LatencySummary GetInputLatency () const;
+    // operator new calls made by the last UpdateDrawFrame (0 unless tracking is built in)
+    std::uint64_t GetFrameAllocations () const {
+      return frameAllocations_;
+    }
   };
 
 } // namespace dotname
@@ -0,0 +1,168 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#ifndef __SIMULATION_HPP
+#define __SIMULATION_HPP
+
+#include <GameEngine/FixedPoint.hpp>
+
+#include <array>
+#include <cstdint>
+
+#include <raylib.h>
+
+// Game rules and state without window, input or audio, so matches can also run headless
+
+namespace dotname {
+
+  // The simulation moves everything a fixed distance per tick, tuned for this many ticks a
+  // second: the game runs at this rate whatever the frame rate, see GameEngine::UpdateGame
+  constexpr int ticksPerSecond = 120;
+
+  // Game constants, in pixels and ticks. Supplied at runtime (tuning sweeps) through
+  // RuntimeRules, or at compile time through StaticRules so the step code folds them.
+  struct Rules {
+    int courtWidth = 800;
+    int courtHeight = 600;
+    int maxLife = 5;
+    int paddleX = 57; // paddle centre
+    int paddleWidth = 14;
+    int paddleHeight = 100;
+    int paddleSpeed = 5;
+    int launchSpeed = 5;
+    int deflection = 5; // vertical ball speed after hitting the paddle edge
+    int ballRadius = 7;
+  };
+
+  // Rules held by each simulation instance
+  struct RuntimeRules {
+    Rules rules;
+
+    RuntimeRules (const Rules& rules = Rules{}) : rules (rules) {
+    }
+    const Rules& get () const {
+      return rules;
+    }
+  };
+
+  // Rules fixed by a rule set type with a `static constexpr Rules value` (C++17 has no class
+  // type template arguments). New rule sets need an instantiation in Simulation.cpp.
+  template <typename RuleSet> struct StaticRules {
+    static constexpr const Rules& get () {
+      return RuleSet::value;
+    }
+  };
+
+  struct ClassicRuleSet {
+    static constexpr Rules value{};
+  };
+
+  // Smaller court, faster ball and three lives
+  struct ArcadeRuleSet {
+    static constexpr Rules value{ 640, 480, 3, 40, 12, 72, 7, 8, 7, 6 };
+  };
+
+  // Scalar is float (raylib Vector2) or Fixed (FixedVector2), see BasicSimulation
+  template <typename Scalar> struct BasicPlayer {
+    typename ScalarTraits<Scalar>::Vector position;
+    typename ScalarTraits<Scalar>::Vector size;
+    int life;
+  };
+
+  template <typename Scalar> struct BasicBall {
+    typename ScalarTraits<Scalar>::Vector position;
+    typename ScalarTraits<Scalar>::Vector speed;
+    int radius;
+    bool active;
+  };
+
+  typedef BasicPlayer<float> Player;
+  typedef BasicBall<float> Ball;
+
+  // Paddle controls for one tick (keyboard or a bot policy). up/down are the fraction of the
+  // tick the key was held, so a bool assigns full travel.
+  struct PaddleInput {
+    float up = 0.0f;
+    float down = 0.0f;
+    bool launch = false;
+  };
+
+  enum class GameEventType : std::uint8_t { WallBounce, PaddleHit, BallLost, GameOver };
+
+  struct GameEvent {
+    GameEventType type;
+    Vector2 position;
+  };
+
+  // Events produced by one tick, fixed capacity so stepping never allocates
+  struct GameEvents {
+    static constexpr int capacity = 16;
+    std::array<GameEvent, capacity> items;
+    int count = 0;
+
+    void push (GameEventType type, Vector2 position) {
+      if (count < capacity)
+        items[count++] = GameEvent{ type, position };
+    }
+    const GameEvent* begin () const {
+      return items.data ();
+    }
+    const GameEvent* end () const {
+      return items.data () + count;
+    }
+  };
+
+  // The same rules compile for float and for Fixed. The float version is what the game
+  // draws; the Fixed version gives bit identical results on every platform, for lockstep
+  // and replay verification between different machines.
+  template <typename Scalar, typename RulesSource = RuntimeRules> class BasicSimulation {
+    RulesSource rules_;
+
+  public:
+    using ScalarType = Scalar;
+    using Traits = ScalarTraits<Scalar>;
+
+    // Contacts resolved per ball step before the rest of the motion is dropped
+    static constexpr int maxBouncesPerStep = 8;
+
+    const int courtWidth;
+    const int courtHeight;
+    BasicPlayer<Scalar> player{};
+    BasicBall<Scalar> ball{};
+    int score = 0;
+    bool gameOver = false;
+    std::uint64_t tick = 0;
+
+    BasicSimulation (const RulesSource& rules = RulesSource{});
+
+    const Rules& rules () const {
+      return rules_.get ();
+    }
+
+    // Start a new game: full lives, ball resting on the paddle
+    void Reset (void);
+    // Advance one fixed tick; the returned events stay valid until the next call
+    const GameEvents& Step (const PaddleInput& input);
+
+  private:
+    void StepBall (void);
+
+    GameEvents events_;
+  };
+
+  // Defined in Simulation.cpp, instantiated for these scalars and rule sources
+  extern template class BasicSimulation<float>;
+  extern template class BasicSimulation<Fixed>;
+  extern template class BasicSimulation<float, StaticRules<ClassicRuleSet>>;
+  extern template class BasicSimulation<Fixed, StaticRules<ClassicRuleSet>>;
+  extern template class BasicSimulation<float, StaticRules<ArcadeRuleSet>>;
+
+  typedef BasicSimulation<float> Simulation;
+  typedef BasicSimulation<Fixed> FixedSimulation;
+  typedef BasicSimulation<float, StaticRules<ClassicRuleSet>> ClassicSimulation;
+  typedef BasicSimulation<Fixed, StaticRules<ClassicRuleSet>> FixedClassicSimulation;
+  typedef BasicSimulation<float, StaticRules<ArcadeRuleSet>> ArcadeSimulation;
+
+} // namespace dotname
+
+#endif // __SIMULATION_HPP
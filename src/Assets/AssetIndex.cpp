@@ -0,0 +1,220 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Content-addressed asset index and persistent decoded-asset cache
+
+#include "AssetIndex.hpp"
+
+#include <Logger/Logger.hpp>
+#include <Utils/Utils.hpp>
+
+#include <charconv>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace Assets {
+
+  namespace {
+    constexpr char cacheMagic[4] = { 'P', 'F', 'D', 'C' };
+    constexpr std::uint32_t cacheVersion = 2;
+
+    struct CacheHeader {
+      char magic[4];
+      std::uint32_t version;
+      std::uint64_t hash; // manifest content hash
+      std::uint64_t assetSize;
+      std::uint64_t sourceChecksum;
+      std::uint64_t payloadSize;
+      std::uint64_t payloadChecksum;
+    };
+
+    // Temporary name for an entry being written. Unique to this process and thread, so
+    // instances (or threads) filling the same entry at once never write into one file.
+    std::filesystem::path temporaryPath (const std::filesystem::path& path) {
+#ifdef _WIN32
+      const unsigned long process = GetCurrentProcessId ();
+#else
+      const long process = static_cast<long> (getpid ());
+#endif
+      const std::size_t thread = std::hash<std::thread::id>{}(std::this_thread::get_id ());
+      auto temporary = path;
+      temporary += "." + std::to_string (process) + "-" + std::to_string (thread) + ".tmp";
+      return temporary;
+    }
+
+    bool nextField (std::string_view& line, std::string_view& field) {
+      if (line.empty ())
+        return false;
+      const auto tab = line.find ('\t');
+      field = line.substr (0, tab);
+      line = tab == std::string_view::npos ? std::string_view () : line.substr (tab + 1);
+      return true;
+    }
+
+    template <typename T> bool parseNumber (std::string_view text, T& value, int base) {
+      const auto result = std::from_chars (text.data (), text.data () + text.size (), value, base);
+      return result.ec == std::errc () && result.ptr == text.data () + text.size ();
+    }
+  } // namespace
+
+  bool AssetIndex::load (const std::filesystem::path& assetsPath) {
+    entries_.clear ();
+    byName_.clear ();
+
+    const auto manifestPath = assetsPath / manifestFileName;
+    if (!std::filesystem::exists (manifestPath))
+      return false;
+
+    try {
+      Utils::FileIO::MappedFile manifest (manifestPath);
+      std::string_view text = manifest.view ();
+      while (!text.empty ()) {
+        const auto newline = text.find ('\n');
+        std::string_view line = text.substr (0, newline);
+        text = newline == std::string_view::npos ? std::string_view () : text.substr (newline + 1);
+        if (!line.empty () && line.back () == '\r')
+          line.remove_suffix (1);
+        if (line.empty () || line.front () == '#')
+          continue;
+
+        std::string_view hash, size, name;
+        AssetEntry entry;
+        if (!nextField (line, hash) || !nextField (line, size) || !nextField (line, name)
+            || !parseNumber (hash, entry.hash, 16) || !parseNumber (size, entry.size, 10)) {
+          LOG_W_STREAM << "Malformed asset manifest: " << manifestPath << std::endl;
+          entries_.clear ();
+          byName_.clear ();
+          return false;
+        }
+        entry.name = std::string (name);
+        byName_[entry.name] = entries_.size ();
+        entries_.push_back (std::move (entry));
+      }
+    } catch (const std::exception& e) {
+      LOG_W_STREAM << "Failed to read asset manifest: " << e.what () << std::endl;
+      entries_.clear ();
+      byName_.clear ();
+      return false;
+    }
+    return true;
+  }
+
+  std::uint64_t checksum (const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const unsigned char*> (data);
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; i++) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  const AssetEntry* AssetIndex::find (std::string_view name) const {
+    const auto it = byName_.find (std::string (name));
+    return it == byName_.end () ? nullptr : &entries_[it->second];
+  }
+
+  DecodedAssetCache::DecodedAssetCache (std::filesystem::path cacheDirectory)
+      : cacheDirectory_ (std::move (cacheDirectory)) {
+  }
+
+  std::filesystem::path DecodedAssetCache::entryPath (const AssetEntry& asset,
+                                                      std::string_view variant) const {
+    char hash[17] = {};
+    std::to_chars (hash, hash + 16, asset.hash, 16);
+    return cacheDirectory_ / (std::string (hash) + "-" + std::string (variant) + ".bin");
+  }
+
+  bool DecodedAssetCache::read (const AssetEntry& asset, std::uint64_t sourceChecksum,
+                                std::string_view variant,
+                                std::vector<std::uint8_t>& payload) const {
+    if (!enabled ())
+      return false;
+    const auto path = entryPath (asset, variant);
+    std::error_code ec;
+    if (!std::filesystem::exists (path, ec))
+      return false;
+
+    try {
+      Utils::FileIO::MappedFile file (path);
+      CacheHeader header;
+      if (file.size () < sizeof (header))
+        return false;
+      std::memcpy (&header, file.data (), sizeof (header));
+      if (std::memcmp (header.magic, cacheMagic, sizeof (cacheMagic)) != 0
+          || header.version != cacheVersion || header.hash != asset.hash
+          || header.assetSize != asset.size || header.sourceChecksum != sourceChecksum
+          || header.payloadSize != file.size () - sizeof (header)
+          || header.payloadChecksum != checksum (file.data () + sizeof (header),
+                                                 file.size () - sizeof (header))) {
+        return false;
+      }
+      payload.assign (file.bytes () + sizeof (header), file.bytes () + file.size ());
+    } catch (const std::exception& e) {
+      LOG_W_STREAM << "Failed to read asset cache entry " << path << " - " << e.what ()
+                   << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  void DecodedAssetCache::write (const AssetEntry& asset, std::uint64_t sourceChecksum,
+                                 std::string_view variant,
+                                 const std::vector<std::uint8_t>& payload) const {
+    if (!enabled ())
+      return;
+    const auto path = entryPath (asset, variant);
+    try {
+      Utils::FileManager::createDirectory (cacheDirectory_);
+      CacheHeader header;
+      std::memcpy (header.magic, cacheMagic, sizeof (cacheMagic));
+      header.version = cacheVersion;
+      header.hash = asset.hash;
+      header.assetSize = asset.size;
+      header.sourceChecksum = sourceChecksum;
+      header.payloadSize = payload.size ();
+      header.payloadChecksum = checksum (payload.data (), payload.size ());
+
+      // Write aside and rename over the entry. Where rename is atomic (POSIX) readers see the
+      // old entry or the new one; a torn entry (a crash, a full disk, a non-atomic rename)
+      // fails the payload checksum and reads as a miss.
+      const auto temporary = temporaryPath (path);
+      {
+        std::ofstream file (temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open ()) {
+          throw std::ios_base::failure ("Failed to open file: " + temporary.string ());
+        }
+        file.write (reinterpret_cast<const char*> (&header), sizeof (header));
+        file.write (reinterpret_cast<const char*> (payload.data ()),
+                    static_cast<std::streamsize> (payload.size ()));
+        if (!file) {
+          throw std::ios_base::failure ("Failed to write file: " + temporary.string ());
+        }
+      }
+      std::error_code ec;
+      std::filesystem::rename (temporary, path, ec);
+#ifdef _WIN32
+      // The rename may not replace an entry that another instance has open or mapped.
+      // Remove the old entry and retry; while it stays in use, keep it and try again on
+      // the next start.
+      if (ec && std::filesystem::exists (path)) {
+        std::error_code removed;
+        if (!std::filesystem::remove (path, removed)) {
+          std::filesystem::remove (temporary, removed);
+          return;
+        }
+        std::filesystem::rename (temporary, path, ec);
+      }
+#endif
+      if (ec) {
+        std::error_code ignored;
+        std::filesystem::remove (temporary, ignored);
+        throw std::filesystem::filesystem_error ("Failed to rename", temporary, path, ec);
+      }
+    } catch (const std::exception& e) {
+      LOG_W_STREAM << "Failed to write asset cache entry " << path << " - " << e.what ()
+                   << std::endl;
+    }
+  }
+
+} // namespace Assets
@@ -0,0 +1,80 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Content-addressed asset index and persistent decoded-asset cache
+
+#ifndef ASSETINDEX_HPP
+#define ASSETINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Assets {
+
+  struct AssetEntry {
+    std::string name;   // path relative to the assets directory
+    std::uint64_t size; // bytes
+    std::uint64_t hash; // first 64 bits of the SHA256 of the content
+  };
+
+  // 64 bit FNV-1a of data. Tells a stale or damaged cache entry from a good one; unlike
+  // AssetEntry::hash it is cheap enough to compute at run time, but not collision resistant.
+  std::uint64_t checksum (const void* data, std::size_t size);
+
+  // Loaded from the manifest generated by cmake/tmplt-asset-manifest.cmake
+  class AssetIndex {
+  public:
+    static constexpr const char* manifestFileName = "assets.manifest";
+
+    // Returns false when the manifest is missing or malformed; the index is left empty
+    bool load (const std::filesystem::path& assetsPath);
+
+    // O(1) lookup by name, nullptr when the asset is unknown
+    const AssetEntry* find (std::string_view name) const;
+
+    const std::vector<AssetEntry>& entries () const {
+      return entries_;
+    }
+    bool empty () const {
+      return entries_.empty ();
+    }
+
+  private:
+    std::vector<AssetEntry> entries_;
+    std::unordered_map<std::string, std::size_t> byName_;
+  };
+
+  // Stores post-processed asset data keyed by the manifest content hash and a variant tag
+  // describing the processing, so unchanged assets skip decoding on the next start. An entry
+  // also records the checksum of the source file it was made from, because the manifest is
+  // generated at configure time and goes stale when an asset is edited in place.
+  class DecodedAssetCache {
+  public:
+    DecodedAssetCache () = default;
+    explicit DecodedAssetCache (std::filesystem::path cacheDirectory);
+
+    bool enabled () const {
+      return !cacheDirectory_.empty ();
+    }
+
+    // Returns false on a miss, when the entry was made from other source content
+    // (sourceChecksum, see checksum ()) or when its payload is damaged
+    bool read (const AssetEntry& asset, std::uint64_t sourceChecksum, std::string_view variant,
+               std::vector<std::uint8_t>& payload) const;
+    // Failures are logged and otherwise ignored, the cache is only an accelerator
+    void write (const AssetEntry& asset, std::uint64_t sourceChecksum, std::string_view variant,
+                const std::vector<std::uint8_t>& payload) const;
+
+  private:
+    std::filesystem::path entryPath (const AssetEntry& asset, std::string_view variant) const;
+
+    std::filesystem::path cacheDirectory_;
+  };
+
+} // namespace Assets
+
+#endif // ASSETINDEX_HPP
@@ -0,0 +1,325 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Note sample bank with optional IMA-ADPCM compressed resident storage
+
+#include "SampleBank.hpp"
+
+#include <Assets/AssetIndex.hpp>
+#include <Logger/Logger.hpp>
+#include <Utils/Utils.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Audio {
+
+  namespace ImaAdpcm {
+    static const int indexTable[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+    static const int stepTable[89]
+        = { 7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,
+            23,    25,    28,    31,    34,    37,    41,    45,    50,    55,    60,    66,
+            73,    80,    88,    97,    107,   118,   130,   143,   157,   173,   190,   209,
+            230,   253,   279,   307,   337,   371,   408,   449,   494,   544,   598,   658,
+            724,   796,   876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+            2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,
+            7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
+            22385, 24623, 27086, 29794, 32767 };
+
+    std::int16_t decodeNibble (State& state, std::uint8_t nibble) {
+      const int step = stepTable[state.stepIndex];
+      int diff = step >> 3;
+      if (nibble & 4)
+        diff += step;
+      if (nibble & 2)
+        diff += step >> 1;
+      if (nibble & 1)
+        diff += step >> 2;
+      state.predictor += (nibble & 8) ? -diff : diff;
+      state.predictor = std::clamp (state.predictor, -32768, 32767);
+      state.stepIndex = std::clamp (state.stepIndex + indexTable[nibble & 0x0f], 0, 88);
+      return static_cast<std::int16_t> (state.predictor);
+    }
+
+    static std::uint8_t encodeSample (State& state, int sample) {
+      const int step = stepTable[state.stepIndex];
+      int diff = sample - state.predictor;
+      std::uint8_t nibble = 0;
+      if (diff < 0) {
+        nibble = 8;
+        diff = -diff;
+      }
+      if (diff >= step) {
+        nibble |= 4;
+        diff -= step;
+      }
+      if (diff >= (step >> 1)) {
+        nibble |= 2;
+        diff -= step >> 1;
+      }
+      if (diff >= (step >> 2))
+        nibble |= 1;
+      // Run the decoder so encoder and decoder predictors never drift apart
+      decodeNibble (state, nibble);
+      return nibble;
+    }
+
+    std::vector<std::uint8_t> encode (const std::int16_t* samples, std::size_t count) {
+      std::vector<std::uint8_t> out ((count + 1) / 2, 0);
+      State state;
+      for (std::size_t i = 0; i < count; i++) {
+        const std::uint8_t nibble = encodeSample (state, samples[i]);
+        out[i / 2] |= (i & 1) ? static_cast<std::uint8_t> (nibble << 4) : nibble;
+      }
+      return out;
+    }
+  } // namespace ImaAdpcm
+
+  std::atomic<SampleBank*> SampleBank::mixingBank_ { nullptr };
+
+  // Decodes the wave straight from a mapped view instead of raylib's LoadFileData copy
+  static Wave loadWave (const std::filesystem::path& file) {
+    Wave wave = {};
+    try {
+      Utils::FileIO::MappedFile mapped (file);
+      if (!mapped.empty ()) {
+        const std::string extension = file.extension ().string ();
+        wave = LoadWaveFromMemory (extension.c_str (), mapped.bytes (),
+                                   static_cast<int> (mapped.size ()));
+      }
+    } catch (const std::exception& e) {
+      LOG_W_STREAM << "Failed to read note sample: " << file << " - " << e.what () << std::endl;
+    }
+    return wave;
+  }
+
+  SampleBank::SampleBank (Storage storage) : requested_ (storage), storage_ (storage) {
+  }
+
+  SampleBank::~SampleBank () {
+    unload ();
+  }
+
+  void SampleBank::load (const std::filesystem::path& assetsPath,
+                         const std::vector<std::string>& fileNames,
+                         const Assets::AssetIndex* index, const Assets::DecodedAssetCache* cache) {
+    unload ();
+    storage_ = requested_;
+    // Claim the mixer before loading, so a bank that cannot mix never holds encoded data
+    if (storage_ == Storage::Adpcm && IsAudioDeviceReady ()) {
+      SampleBank* idle = nullptr;
+      if (!mixingBank_.compare_exchange_strong (idle, this)) {
+        LOG_W_STREAM << "Another IMA-ADPCM sample bank owns the mixer stream, the notes from "
+                     << assetsPath << " are loaded as PCM" << std::endl;
+        storage_ = Storage::Pcm;
+      }
+    }
+    for (const auto& fileName : fileNames) {
+      const Assets::AssetEntry* asset = index ? index->find (fileName) : nullptr;
+      if (storage_ == Storage::Pcm) {
+        loadPcm (assetsPath / fileName);
+      } else {
+        loadAdpcm (assetsPath / fileName, asset, cache);
+      }
+    }
+
+    if (storage_ == Storage::Adpcm && IsAudioDeviceReady ()) {
+      stream_ = LoadAudioStream (mixSampleRate, 32, 1);
+      SetAudioStreamCallback (stream_, &SampleBank::mixCallback);
+      PlayAudioStream (stream_);
+      streamReady_ = true;
+    }
+  }
+
+  void SampleBank::unload () {
+    if (streamReady_) {
+      StopAudioStream (stream_);
+      UnloadAudioStream (stream_);
+      streamReady_ = false;
+    }
+    SampleBank* self = this;
+    mixingBank_.compare_exchange_strong (self, nullptr);
+    for (auto& sound : sounds_) {
+      if (sound.frameCount > 0) {
+        UnloadSound (sound);
+      }
+    }
+    sounds_.clear ();
+    encoded_.clear ();
+    voices_ = {};
+    activeVoices_.store (0, std::memory_order_relaxed);
+    triggerHead_.store (0);
+    triggerTail_.store (0);
+  }
+
+  void SampleBank::loadPcm (const std::filesystem::path& file) {
+    Sound sound = {};
+    if (std::filesystem::exists (file)) {
+      Wave wave = loadWave (file);
+      if (wave.data != nullptr) {
+        sound = LoadSoundFromWave (wave);
+        UnloadWave (wave);
+      }
+    } else {
+      LOG_W_STREAM << "Missing note sample: " << file << std::endl;
+    }
+    sounds_.push_back (sound);
+  }
+
+  void SampleBank::loadAdpcm (const std::filesystem::path& file, const Assets::AssetEntry* asset,
+                             const Assets::DecodedAssetCache* cache) {
+    // Cache payload: frame count followed by the encoded nibbles
+    static constexpr std::string_view cacheVariant = "adpcm1-48000-mono";
+    EncodedSample sample;
+
+    // Entries are matched against the file as it is now, the manifest may predate an edit
+    bool useCache = asset != nullptr && cache != nullptr && cache->enabled ();
+    std::uint64_t sourceChecksum = 0;
+    if (useCache) {
+      try {
+        Utils::FileIO::MappedFile source (file);
+        useCache = source.size () == asset->size;
+        sourceChecksum = Assets::checksum (source.data (), source.size ());
+      } catch (const std::exception&) {
+        useCache = false;
+      }
+    }
+    std::vector<std::uint8_t> payload;
+    if (useCache && cache->read (*asset, sourceChecksum, cacheVariant, payload)
+        && payload.size () >= sizeof (std::uint64_t)) {
+      std::uint64_t frameCount = 0;
+      std::memcpy (&frameCount, payload.data (), sizeof (frameCount));
+      sample.data.assign (payload.begin () + sizeof (frameCount), payload.end ());
+      if (sample.data.size () == (frameCount + 1) / 2) {
+        sample.frameCount = static_cast<std::size_t> (frameCount);
+        encoded_.push_back (std::move (sample));
+        return;
+      }
+      sample = EncodedSample{};
+    }
+
+    if (std::filesystem::exists (file)) {
+      Wave wave = loadWave (file);
+      if (wave.data != nullptr) {
+        // Mono 16 bit at the mixer rate, so the callback only has to decode nibbles
+        WaveFormat (&wave, mixSampleRate, 16, 1);
+        sample.data = ImaAdpcm::encode (static_cast<const std::int16_t*> (wave.data),
+                                        wave.frameCount);
+        sample.frameCount = wave.frameCount;
+        UnloadWave (wave);
+      }
+    } else {
+      LOG_W_STREAM << "Missing note sample: " << file << std::endl;
+    }
+
+    if (useCache && sample.frameCount > 0) {
+      const std::uint64_t frameCount = sample.frameCount;
+      payload.resize (sizeof (frameCount));
+      std::memcpy (payload.data (), &frameCount, sizeof (frameCount));
+      payload.insert (payload.end (), sample.data.begin (), sample.data.end ());
+      cache->write (*asset, sourceChecksum, cacheVariant, payload);
+    }
+    encoded_.push_back (std::move (sample));
+  }
+
+  void SampleBank::play (std::size_t index) {
+    if (index >= size ())
+      return;
+
+    if (storage_ == Storage::Pcm) {
+      if (sounds_[index].frameCount > 0)
+        PlaySound (sounds_[index]);
+      return;
+    }
+
+    if (!streamReady_ || encoded_[index].frameCount == 0)
+      return;
+    const std::size_t head = triggerHead_.load (std::memory_order_relaxed);
+    const std::size_t next = (head + 1) % triggerCapacity;
+    if (next == triggerTail_.load (std::memory_order_acquire))
+      return; // queue full, the note is dropped like an exhausted raylib sound pool
+    triggers_[head] = static_cast<std::uint16_t> (index);
+    triggerHead_.store (next, std::memory_order_release);
+  }
+
+  std::size_t SampleBank::activeVoices () const {
+    if (storage_ == Storage::Adpcm)
+      return activeVoices_.load (std::memory_order_relaxed);
+    std::size_t playing = 0;
+    for (const auto& sound : sounds_) {
+      if (sound.frameCount > 0 && IsSoundPlaying (sound))
+        playing++;
+    }
+    return playing;
+  }
+
+  std::size_t SampleBank::residentBytes () const {
+    std::size_t bytes = 0;
+    for (const auto& sound : sounds_) {
+      bytes += static_cast<std::size_t> (sound.frameCount) * sound.stream.channels
+               * sound.stream.sampleSize / 8;
+    }
+    for (const auto& sample : encoded_) {
+      bytes += sample.data.capacity ();
+    }
+    if (storage_ == Storage::Adpcm)
+      bytes += sizeof (voices_) + sizeof (triggers_);
+    return bytes;
+  }
+
+  void SampleBank::mixCallback (void* bufferData, unsigned int frames) {
+    float* out = static_cast<float*> (bufferData);
+    SampleBank* bank = mixingBank_.load (std::memory_order_acquire);
+    if (bank == nullptr) {
+      std::fill (out, out + frames, 0.0f);
+      return;
+    }
+    bank->mix (out, frames);
+  }
+
+  void SampleBank::mix (float* out, unsigned int frames) {
+    // Start queued notes; when every voice is busy the most advanced one is stolen
+    std::size_t tail = triggerTail_.load (std::memory_order_relaxed);
+    while (tail != triggerHead_.load (std::memory_order_acquire)) {
+      Voice* target = &voices_[0];
+      for (auto& voice : voices_) {
+        if (voice.sample == nullptr) {
+          target = &voice;
+          break;
+        }
+        if (voice.position > target->position)
+          target = &voice;
+      }
+      *target = Voice{ &encoded_[triggers_[tail]], 0, {} };
+      tail = (tail + 1) % triggerCapacity;
+    }
+    triggerTail_.store (tail, std::memory_order_release);
+
+    std::fill (out, out + frames, 0.0f);
+    std::size_t active = 0;
+    for (auto& voice : voices_) {
+      if (voice.sample == nullptr)
+        continue;
+      const std::uint8_t* data = voice.sample->data.data ();
+      const std::size_t end = std::min (voice.sample->frameCount, voice.position + frames);
+      float* dst = out;
+      for (std::size_t i = voice.position; i < end; i++) {
+        const std::uint8_t byte = data[i / 2];
+        const std::uint8_t nibble = (i & 1) ? (byte >> 4) : (byte & 0x0f);
+        *dst++ += ImaAdpcm::decodeNibble (voice.state, nibble) * (1.0f / 32768.0f);
+      }
+      voice.position = end;
+      if (voice.position >= voice.sample->frameCount) {
+        voice = Voice{};
+      } else {
+        active++;
+      }
+    }
+    activeVoices_.store (active, std::memory_order_relaxed);
+
+    for (unsigned int i = 0; i < frames; i++) {
+      out[i] = std::clamp (out[i], -1.0f, 1.0f);
+    }
+  }
+
+} // namespace Audio
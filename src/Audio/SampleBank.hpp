@@ -0,0 +1,119 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Note sample bank with optional IMA-ADPCM compressed resident storage
+
+#ifndef SAMPLEBANK_HPP
+#define SAMPLEBANK_HPP
+
+#include <raylib.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Assets {
+  class AssetIndex;
+  class DecodedAssetCache;
+  struct AssetEntry;
+}
+
+namespace Audio {
+
+  // IMA-ADPCM (4 bits per sample) codec used for the compressed storage
+  namespace ImaAdpcm {
+    struct State {
+      int predictor = 0;
+      int stepIndex = 0;
+    };
+
+    std::vector<std::uint8_t> encode (const std::int16_t* samples, std::size_t count);
+    std::int16_t decodeNibble (State& state, std::uint8_t nibble);
+  } // namespace ImaAdpcm
+
+  class SampleBank {
+  public:
+    enum class Storage {
+      Pcm,  // decoded raylib Sound per note (default, played by raylib mixer)
+      Adpcm // 4:1 compressed mono, decoded per voice inside the stream callback
+    };
+
+    static constexpr unsigned int mixSampleRate = 48000;
+    static constexpr std::size_t maxVoices = 16;
+
+    explicit SampleBank (Storage storage = Storage::Pcm);
+    ~SampleBank ();
+
+    SampleBank (const SampleBank&) = delete;
+    SampleBank& operator= (const SampleBank&) = delete;
+
+    // Loads one sample per file name; missing files leave an empty slot. With an index and
+    // cache, compressed samples of unchanged assets are taken from the cache instead of
+    // being decoded and encoded again.
+    void load (const std::filesystem::path& assetsPath, const std::vector<std::string>& fileNames,
+               const Assets::AssetIndex* index = nullptr,
+               const Assets::DecodedAssetCache* cache = nullptr);
+    void unload ();
+
+    // Thread safe fire-and-forget trigger; out of range or empty slots are ignored
+    void play (std::size_t index);
+
+    // Storage of the loaded samples: Pcm when the bank asked for Adpcm but another bank
+    // owns the mixer stream
+    Storage storage () const {
+      return storage_;
+    }
+    std::size_t size () const {
+      return storage_ == Storage::Pcm ? sounds_.size () : encoded_.size ();
+    }
+    // Bytes currently held by decoded or encoded sample data and mixer voices
+    std::size_t residentBytes () const;
+    // Notes sounding: PCM sounds raylib is playing, or voices the ADPCM mixer decoded last
+    std::size_t activeVoices () const;
+
+  private:
+    struct EncodedSample {
+      std::vector<std::uint8_t> data;
+      std::size_t frameCount = 0;
+    };
+
+    struct Voice {
+      const EncodedSample* sample = nullptr;
+      std::size_t position = 0;
+      ImaAdpcm::State state;
+    };
+
+    static void mixCallback (void* bufferData, unsigned int frames);
+    void mix (float* out, unsigned int frames);
+    void loadPcm (const std::filesystem::path& file);
+    void loadAdpcm (const std::filesystem::path& file, const Assets::AssetEntry* asset,
+                    const Assets::DecodedAssetCache* cache);
+
+    const Storage requested_;
+    Storage storage_;
+    std::vector<Sound> sounds_;
+    std::vector<EncodedSample> encoded_;
+
+    // Mixer state for Storage::Adpcm, owned by the audio thread after startup
+    AudioStream stream_ = {};
+    bool streamReady_ = false;
+    std::array<Voice, maxVoices> voices_ = {};
+    std::atomic<std::size_t> activeVoices_ { 0 };
+
+    // Single producer (game thread) / single consumer (audio thread) trigger queue
+    static constexpr std::size_t triggerCapacity = 64;
+    std::array<std::uint16_t, triggerCapacity> triggers_ = {};
+    std::atomic<std::size_t> triggerHead_ { 0 };
+    std::atomic<std::size_t> triggerTail_ { 0 };
+
+    // raylib stream callbacks carry no user pointer, so one ADPCM bank per process mixes;
+    // load () of another one while it is open loads that bank as PCM instead
+    static std::atomic<SampleBank*> mixingBank_;
+  };
+
+} // namespace Audio
+
+#endif // SAMPLEBANK_HPP
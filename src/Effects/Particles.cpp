@@ -0,0 +1,106 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Fixed capacity structure of arrays particle pool for hit and life loss effects
+
+#include "Particles.hpp"
+
+#include <Render/DrawList.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_MSC_VER)
+  #define PARTICLES_RESTRICT __restrict
+#else
+  #define PARTICLES_RESTRICT __restrict__
+#endif
+
+namespace Effects {
+
+  namespace {
+    // Branch free over independent arrays so it compiles to packed SIMD. The arrays are
+    // parameters because compilers only honour restrict on function parameters.
+    void integrate (float* PARTICLES_RESTRICT x, float* PARTICLES_RESTRICT y,
+                    float* PARTICLES_RESTRICT vx, float* PARTICLES_RESTRICT vy,
+                    float* PARTICLES_RESTRICT life, const float* PARTICLES_RESTRICT decay,
+                    std::size_t count, float dt, float keep, float fall) {
+      for (std::size_t i = 0; i < count; i++) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        vx[i] *= keep;
+        vy[i] = vy[i] * keep + fall;
+        life[i] -= decay[i] * dt;
+      }
+    }
+  } // namespace
+
+  ParticlePool::ParticlePool (std::size_t capacity, std::uint64_t seed)
+      : capacity_ (capacity), x_ (capacity), y_ (capacity), vx_ (capacity), vy_ (capacity),
+        life_ (capacity), decay_ (capacity), color_ (capacity), random_ (seed) {
+  }
+
+  // splitmix64, uniform in [0, 1)
+  float ParticlePool::random () {
+    std::uint64_t z = (random_ += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z ^= z >> 31;
+    return static_cast<float> (z >> 40) / static_cast<float> (1ull << 24);
+  }
+
+  std::size_t ParticlePool::emit (Vector2 position, int count, const EmitterSettings& settings) {
+    const std::size_t wanted = count > 0 ? static_cast<std::size_t> (count) : 0;
+    const std::size_t spawned = std::min (wanted, capacity_ - count_);
+    dropped_ += wanted - spawned;
+
+    const float baseAngle = std::atan2 (settings.direction.y, settings.direction.x);
+    for (std::size_t n = 0; n < spawned; n++) {
+      const std::size_t i = count_++;
+      const float angle = baseAngle + (random () * 2.0f - 1.0f) * settings.spread;
+      const float speed = settings.minSpeed + random () * (settings.maxSpeed - settings.minSpeed);
+      x_[i] = position.x;
+      y_[i] = position.y;
+      vx_[i] = std::cos (angle) * speed;
+      vy_[i] = std::sin (angle) * speed;
+      life_[i] = 1.0f;
+      decay_[i] = 1.0f / (settings.lifetime * (0.5f + 0.5f * random ()));
+      color_[i] = settings.color;
+    }
+    return spawned;
+  }
+
+  void ParticlePool::update (float dt) {
+    integrate (x_.data (), y_.data (), vx_.data (), vy_.data (), life_.data (), decay_.data (),
+               count_, dt, std::pow (drag, dt), gravity * dt);
+
+    // Swap remove: the last live particle fills each dead slot, order is not kept
+    std::size_t i = 0;
+    std::size_t live = count_;
+    while (i < live) {
+      if (life_[i] > 0.0f) {
+        i++;
+        continue;
+      }
+      live--;
+      x_[i] = x_[live];
+      y_[i] = y_[live];
+      vx_[i] = vx_[live];
+      vy_[i] = vy_[live];
+      life_[i] = life_[live];
+      decay_[i] = decay_[live];
+      color_[i] = color_[live];
+    }
+    count_ = live;
+  }
+
+  void ParticlePool::draw (Render::DrawList& drawList, int layer) const {
+    for (std::size_t i = 0; i < count_; i++) {
+      Color color = color_[i];
+      color.a = static_cast<unsigned char> (color.a * life_[i]);
+      const float size = 1.5f + 2.0f * life_[i];
+      drawList.rectangle (Rectangle{ x_[i] - size / 2, y_[i] - size / 2, size, size }, color,
+                          layer);
+    }
+  }
+
+} // namespace Effects
@@ -0,0 +1,76 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Fixed capacity structure of arrays particle pool for hit and life loss effects
+
+#ifndef PARTICLES_HPP
+#define PARTICLES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <raylib.h>
+
+namespace Render {
+  class DrawList;
+}
+
+namespace Effects {
+
+  struct EmitterSettings {
+    Vector2 direction = { 1.0f, 0.0f }; // centre of the cone
+    float spread = 3.1416f;             // cone half angle in radians, pi is a full circle
+    float minSpeed = 60.0f;             // pixels per second
+    float maxSpeed = 240.0f;
+    float lifetime = 0.6f;              // seconds, each particle gets 50-100 % of it
+    Color color = MAROON;
+  };
+
+  // Every attribute lives in its own array, so update () streams through plain float arrays
+  // that the compiler vectorises. Storage is allocated once, dead particles are removed by
+  // moving the last live one into their slot.
+  class ParticlePool {
+  public:
+    explicit ParticlePool (std::size_t capacity = 100000, std::uint64_t seed = 0x9e3779b9ull);
+
+    // Spawns count particles at position, fewer when the pool is full (see dropped ())
+    std::size_t emit (Vector2 position, int count, const EmitterSettings& settings);
+    // Integrate, apply drag and gravity, fade, then compact
+    void update (float dt);
+    void draw (Render::DrawList& drawList, int layer = 0) const;
+    void clear () {
+      count_ = 0;
+    }
+
+    std::size_t size () const {
+      return count_;
+    }
+    std::size_t capacity () const {
+      return capacity_;
+    }
+    std::uint64_t dropped () const {
+      return dropped_;
+    }
+
+    float gravity = 360.0f; // pixels per second squared, downwards
+    float drag = 0.9f;      // fraction of velocity kept per second
+
+  private:
+    float random ();
+
+    std::size_t capacity_;
+    std::size_t count_ = 0;
+    std::vector<float> x_;
+    std::vector<float> y_;
+    std::vector<float> vx_;
+    std::vector<float> vy_;
+    std::vector<float> life_;  // 1 when spawned, dead at 0
+    std::vector<float> decay_; // life lost per second
+    std::vector<Color> color_;
+    std::uint64_t random_;
+    std::uint64_t dropped_ = 0;
+  };
+
+} // namespace Effects
+
+#endif // PARTICLES_HPP
@@ -0,0 +1,104 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <GameEngine/EngineGroup.hpp>
+#include <Input/InputPipeline.hpp>
+#include <Logger/Logger.hpp>
+#include <Timing/FramePacer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+namespace dotname {
+
+  namespace {
+    // Columns of a near square grid, wider than tall for two engines
+    std::size_t gridColumns (std::size_t count) {
+      return std::max<std::size_t> (
+          1, static_cast<std::size_t> (std::ceil (std::sqrt (static_cast<double> (count)))));
+    }
+  } // namespace
+
+  EngineGroup::EngineGroup (const EngineConfig& config) {
+    Timing::PacingConfig pacing;
+    pacing.maxFps = config.targetFps;
+    pacing.powerBudget = config.powerBudget;
+    pacing.idleThrottle = config.idleThrottle;
+    pacer_ = std::make_unique<Timing::FramePacer> (pacing);
+  }
+
+  EngineGroup::~EngineGroup () {
+    pacer_->stop ();
+  }
+
+  void EngineGroup::add (GameEngine& engine) {
+    engines_.push_back (&engine);
+  }
+
+  Rectangle EngineGroup::tile (std::size_t index) const {
+    const std::size_t columns = gridColumns (engines_.size ());
+    const std::size_t rows = std::max<std::size_t> (1, (engines_.size () + columns - 1) / columns);
+    const float width = static_cast<float> (GetScreenWidth ()) / columns;
+    const float height = static_cast<float> (GetScreenHeight ()) / rows;
+    return Rectangle{ (index % columns) * width, (index / columns) * height, width, height };
+  }
+
+  bool EngineGroup::tick () {
+    using Seconds = std::chrono::duration<double>;
+    if (WindowShouldClose ()) // Detect window close button or ESC key
+      return false;
+    if (!started_) {
+      pacer_->start ();
+      started_ = true;
+    }
+    const auto frameStart = std::chrono::steady_clock::now ();
+    const Seconds interval = lastFrameStart_ == std::chrono::steady_clock::time_point{}
+                                 ? Seconds (0.0)
+                                 : Seconds (frameStart - lastFrameStart_);
+    lastFrameStart_ = frameStart;
+
+    const Input::PressedKeys pressed = Input::PressedKeys::collect ();
+    for (GameEngine* engine : engines_)
+      engine->Update (pressed);
+    for (GameEngine* engine : engines_)
+      engine->Render ();
+
+    BeginDrawing ();
+    ClearBackground (BLACK);
+    for (std::size_t i = 0; i < engines_.size (); i++)
+      engines_[i]->Present (tile (i));
+    const auto submitted = std::chrono::steady_clock::now ();
+    EndDrawing ();
+
+    // Engines judge the frame with the pacing that governed it, before the pacer moves on
+    bool idle = true;
+    for (GameEngine* engine : engines_) {
+      engine->FrameDone (pacer_->stats ());
+      idle = idle && engine->IsIdle ();
+    }
+    pacer_->frameDone (Seconds (submitted - frameStart).count (), interval.count (), idle);
+    return true;
+  }
+
+  void EngineGroup::run () {
+    if (engines_.size () > 1) {
+      const std::size_t columns = gridColumns (engines_.size ());
+      const std::size_t rows = (engines_.size () + columns - 1) / columns;
+      SetWindowSize (static_cast<int> (columns) * engines_.front ()->screenWidth,
+                     static_cast<int> (rows) * engines_.front ()->screenHeight);
+    }
+
+    // Main game loop
+    while (tick ()) {
+    }
+
+    pacer_->stop ();
+    const Timing::PacingStats& pacingStats = pacer_->stats ();
+    LOG_I_FMT ("Frame pacing: {} frames rendered, {} skipped, ~{:.2f} s of frame work saved, "
+               "{:.2f} s process CPU time",
+               pacingStats.framesRendered, pacingStats.framesSkipped,
+               pacingStats.cpuSecondsSaved, static_cast<double> (std::clock ()) / CLOCKS_PER_SEC);
+  }
+
+} // namespace dotname
@@ -0,0 +1,486 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Always on crash recorder: recent inputs, state, frame timings and log lines in a mapped file
+
+#include "FlightRecorder.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+namespace FlightRecorder {
+
+  namespace {
+    constexpr std::uint32_t fileVersion = 1;
+    // Input and frame records every frame at 120 Hz, snapshots and log lines on top
+    constexpr double slotsPerSecond = 320.0;
+    constexpr std::uint64_t minSlots = 1024;
+    // Log lines span at most this many slots; the first one gives up two bytes to the header
+    constexpr std::size_t maxLogSlots = 4;
+    constexpr std::size_t logHeaderBytes = 2;
+
+    static_assert (sizeof (FileHeader) <= headerBytes, "header fits its page");
+
+    void packRules (const dotname::Rules& rules, std::int32_t* packed) {
+      const int values[] = { rules.courtWidth,   rules.courtHeight, rules.maxLife,
+                             rules.paddleX,      rules.paddleWidth, rules.paddleHeight,
+                             rules.paddleSpeed,  rules.launchSpeed, rules.deflection,
+                             rules.ballRadius };
+      static_assert (std::size (values) == std::size (FileHeader{}.rules), "every rule packed");
+      std::copy (std::begin (values), std::end (values), packed);
+    }
+
+    dotname::Rules unpackRules (const std::int32_t* packed) {
+      dotname::Rules rules;
+      int* fields[] = { &rules.courtWidth,  &rules.courtHeight, &rules.maxLife,
+                        &rules.paddleX,     &rules.paddleWidth, &rules.paddleHeight,
+                        &rules.paddleSpeed, &rules.launchSpeed, &rules.deflection,
+                        &rules.ballRadius };
+      for (std::size_t i = 0; i < std::size (fields); i++)
+        *fields[i] = packed[i];
+      return rules;
+    }
+
+    // Fields of the mapped file shared between threads, and with a reader of the file. The
+    // file holds plain integers; lock free atomics of the same size have the same layout.
+    template <typename T> std::atomic<T>& shared (T& value) {
+      static_assert (std::atomic<T>::is_always_lock_free && sizeof (std::atomic<T>) == sizeof (T),
+                     "mapped fields need address free atomics");
+      return *reinterpret_cast<std::atomic<T>*> (&value);
+    }
+
+    // The recorder fatal signals are noted in, see attachProcess ()
+    std::atomic<FlightRecorder*> activeRecorder{ nullptr };
+
+    void logTap (void* context, Logger::Level level, const char* message, std::size_t length) {
+      static_cast<FlightRecorder*> (context)->log (static_cast<int> (level), message, length);
+    }
+
+    // Noted before the process ends, and then handled as before: shutdown requests are not
+    // crashes, the rest are
+    void noteSignal (int signal) {
+      FlightRecorder* recorder = activeRecorder.load ();
+      if (!recorder)
+        return;
+      if (signal == SIGINT || signal == SIGTERM)
+        recorder->interrupted (signal);
+      else
+        recorder->crashed (signal);
+    }
+
+#ifdef _WIN32
+    constexpr int fatalSignals[] = { SIGABRT, SIGINT, SIGTERM };
+
+    void onSignal (int signal) {
+      noteSignal (signal);
+      std::signal (signal, SIG_DFL);
+      std::raise (signal);
+    }
+
+    LONG WINAPI onException (EXCEPTION_POINTERS* exception) {
+      if (FlightRecorder* recorder = activeRecorder.load ())
+        recorder->crashed (static_cast<int> (exception->ExceptionRecord->ExceptionCode));
+      return EXCEPTION_CONTINUE_SEARCH;
+    }
+
+    void installCrashHandlers () {
+      for (int signal : fatalSignals)
+        std::signal (signal, onSignal);
+      SetUnhandledExceptionFilter (onException);
+    }
+#else
+    constexpr int fatalSignals[] = { SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT, SIGTERM, SIGINT };
+    struct sigaction previousActions[std::size (fatalSignals)];
+
+    void onSignal (int signal) {
+      noteSignal (signal);
+      // Whatever handled the signal before (usually the default action) finishes the job
+      for (std::size_t i = 0; i < std::size (fatalSignals); i++)
+        if (fatalSignals[i] == signal)
+          sigaction (signal, &previousActions[i], nullptr);
+      raise (signal);
+    }
+
+    void installCrashHandlers () {
+      // A stack overflow leaves no stack to run the handler on. The alternate stack is per
+      // thread and only this one gets it; threads the engine and raylib start elsewhere run
+      // the handler on their own stack, which is enough for every fault but an overflow.
+      static std::vector<char> alternateStack (1 << 16);
+      stack_t stack{};
+      stack.ss_sp = alternateStack.data ();
+      stack.ss_size = alternateStack.size ();
+      sigaltstack (&stack, nullptr);
+
+      struct sigaction action {};
+      action.sa_handler = onSignal;
+      action.sa_flags = SA_ONSTACK;
+      sigemptyset (&action.sa_mask);
+      for (std::size_t i = 0; i < std::size (fatalSignals); i++)
+        sigaction (fatalSignals[i], &action, &previousActions[i]);
+    }
+#endif
+
+    std::uint64_t roundUpToPowerOfTwo (std::uint64_t value) {
+      std::uint64_t size = minSlots;
+      while (size < value)
+        size <<= 1;
+      return size;
+    }
+  } // namespace
+
+  FlightRecorder::~FlightRecorder () {
+    close ();
+  }
+
+  bool FlightRecorder::open (const std::filesystem::path& path, double seconds,
+                             const dotname::Rules& rules) {
+    close ();
+    const std::uint64_t slotCount = roundUpToPowerOfTwo (
+        static_cast<std::uint64_t> (std::max (0.0, seconds) * slotsPerSecond));
+    const std::size_t size = headerBytes + static_cast<std::size_t> (slotCount) * slotBytes;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW (path.c_str (), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                               nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      LOG_E_STREAM << "Flight recorder: cannot create " << path << std::endl;
+      return false;
+    }
+    const std::uint64_t size64 = size;
+    HANDLE mapping = CreateFileMappingW (file, nullptr, PAGE_READWRITE,
+                                         static_cast<DWORD> (size64 >> 32),
+                                         static_cast<DWORD> (size64), nullptr);
+    void* view = mapping ? MapViewOfFile (mapping, FILE_MAP_ALL_ACCESS, 0, 0, size) : nullptr;
+    if (!view) {
+      LOG_E_STREAM << "Flight recorder: cannot map " << path << std::endl;
+      if (mapping)
+        CloseHandle (mapping);
+      CloseHandle (file);
+      return false;
+    }
+    file_ = file;
+    mapping_ = mapping;
+#else
+    const int file = ::open (path.c_str (), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) {
+      LOG_E_STREAM << "Flight recorder: cannot create " << path << ": " << std::strerror (errno)
+                   << std::endl;
+      return false;
+    }
+    void* view = MAP_FAILED;
+    if (ftruncate (file, static_cast<off_t> (size)) == 0)
+      view = mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    const int error = errno;
+    ::close (file); // the mapping keeps the file open
+    if (view == MAP_FAILED) {
+      LOG_E_STREAM << "Flight recorder: cannot map " << path << ": " << std::strerror (error)
+                   << std::endl;
+      return false;
+    }
+#endif
+    // Touch every page now, so recording never faults in a page in the middle of a frame
+    std::memset (view, 0, size);
+
+    header_ = static_cast<FileHeader*> (view);
+    slots_ = reinterpret_cast<Slot*> (static_cast<std::uint8_t*> (view) + headerBytes);
+    mask_ = slotCount - 1;
+    mappedBytes_ = size;
+    start_ = std::chrono::steady_clock::now ();
+
+    std::memcpy (header_->magic, fileMagic, sizeof (header_->magic));
+    header_->version = fileVersion;
+    header_->slotBytes = slotBytes;
+    header_->slotCount = slotCount;
+    header_->startUnixMs = static_cast<std::uint64_t> (
+        std::chrono::duration_cast<std::chrono::milliseconds> (
+            std::chrono::system_clock::now ().time_since_epoch ())
+            .count ());
+    packRules (rules, header_->rules);
+    shared (header_->state).store (static_cast<std::uint32_t> (RunState::Running),
+                                   std::memory_order_release);
+
+    marker (Marker::Started);
+    LOG_I_FMT ("Flight recorder: {} slots ({} KiB) in {}", slotCount, size / 1024, path.string ());
+    return true;
+  }
+
+  void FlightRecorder::close () {
+    if (!header_)
+      return;
+    FlightRecorder* self = this;
+    activeRecorder.compare_exchange_strong (self, nullptr);
+    LOG.clearTap (this);
+
+    marker (Marker::Stopped);
+    shared (header_->state).store (static_cast<std::uint32_t> (RunState::Stopped),
+                                   std::memory_order_release);
+#ifdef _WIN32
+    UnmapViewOfFile (header_);
+    CloseHandle (mapping_);
+    CloseHandle (file_);
+    mapping_ = file_ = nullptr;
+#else
+    munmap (header_, mappedBytes_);
+#endif
+    header_ = nullptr;
+    slots_ = nullptr;
+    mappedBytes_ = 0;
+  }
+
+  void FlightRecorder::attachProcess () {
+    if (!header_)
+      return;
+    static std::once_flag installed;
+    std::call_once (installed, installCrashHandlers);
+    activeRecorder.store (this);
+    LOG.setTap (logTap, this);
+  }
+
+  void FlightRecorder::input (std::uint64_t tick, const dotname::PaddleInput& paddle,
+                              bool stepped, bool pause, bool restart) {
+    InputRecord record{};
+    record.tick = tick;
+    record.up = paddle.up;
+    record.down = paddle.down;
+    record.launch = paddle.launch;
+    record.stepped = stepped;
+    record.pause = pause;
+    record.restart = restart;
+    write (RecordType::Input, &record, sizeof (record));
+  }
+
+  void FlightRecorder::log (int level, const char* text, std::size_t length) {
+    if (!header_)
+      return;
+    while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r'))
+      length--;
+    length = std::min (length, maxLogSlots * payloadBytes - logHeaderBytes);
+    const std::size_t count = (length + logHeaderBytes + payloadBytes - 1) / payloadBytes;
+
+    // Consecutive slots, so the reader finds the continuation right after the first one
+    const std::uint64_t sequence
+        = shared (header_->next).fetch_add (count, std::memory_order_relaxed);
+    std::uint8_t first[payloadBytes];
+    first[0] = static_cast<std::uint8_t> (level);
+    first[1] = static_cast<std::uint8_t> (count);
+    const std::size_t head = std::min (length, payloadBytes - logHeaderBytes);
+    std::memcpy (first + logHeaderBytes, text, head);
+    writeSlot (sequence, RecordType::Log, first, logHeaderBytes + head);
+    for (std::size_t i = 1, at = head; i < count; i++, at += payloadBytes)
+      writeSlot (sequence + i, RecordType::LogContinued, text + at,
+                 std::min (payloadBytes, length - at));
+  }
+
+  void FlightRecorder::marker (Marker marker, int signal) {
+    MarkerRecord record{};
+    record.marker = static_cast<std::uint8_t> (marker);
+    record.signal = signal;
+    write (RecordType::Marker, &record, sizeof (record));
+  }
+
+  void FlightRecorder::crashed (int signal) {
+    if (!header_)
+      return;
+    marker (Marker::Signal, signal);
+    header_->signal = signal;
+    shared (header_->state).store (static_cast<std::uint32_t> (RunState::Crashed),
+                                   std::memory_order_release);
+  }
+
+  void FlightRecorder::interrupted (int signal) {
+    if (!header_)
+      return;
+    marker (Marker::Interrupted, signal);
+    header_->signal = signal;
+    shared (header_->state).store (static_cast<std::uint32_t> (RunState::Interrupted),
+                                   std::memory_order_release);
+  }
+
+  void FlightRecorder::write (RecordType type, const void* payload, std::size_t length) {
+    if (!header_)
+      return;
+    const std::uint64_t sequence = shared (header_->next).fetch_add (1, std::memory_order_relaxed);
+    writeSlot (sequence, type, payload, length);
+  }
+
+  void FlightRecorder::writeSlot (std::uint64_t sequence, RecordType type, const void* payload,
+                                  std::size_t length) {
+    Slot& slot = slots_[sequence & mask_];
+    std::atomic<std::uint64_t>& published = shared (slot.sequence);
+    // Readers skip the slot from here until the new sequence is stored
+    published.store (0, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+    slot.type = static_cast<std::uint16_t> (type);
+    slot.length = static_cast<std::uint16_t> (length);
+    slot.timeMs = elapsedMs ();
+    std::memcpy (slot.payload, payload, length);
+    published.store (sequence + 1, std::memory_order_release);
+  }
+
+  std::uint32_t FlightRecorder::elapsedMs () const {
+    return static_cast<std::uint32_t> (std::chrono::duration_cast<std::chrono::milliseconds> (
+                                           std::chrono::steady_clock::now () - start_)
+                                           .count ());
+  }
+
+  bool read (const std::filesystem::path& path, FlightLog& log) {
+    log = FlightLog{};
+    std::ifstream file (path, std::ios::binary);
+    if (!file) {
+      LOG_E_STREAM << "Flight recorder: cannot open " << path << std::endl;
+      return false;
+    }
+    std::vector<std::uint8_t> data ((std::istreambuf_iterator<char> (file)),
+                                    std::istreambuf_iterator<char> ());
+    FileHeader header;
+    if (data.size () < headerBytes) {
+      LOG_E_STREAM << "Flight recorder: " << path << " is too short" << std::endl;
+      return false;
+    }
+    std::memcpy (&header, data.data (), sizeof (header));
+    const std::uint64_t slotCount = header.slotCount;
+    if (std::memcmp (header.magic, fileMagic, sizeof (header.magic)) != 0
+        || header.version != fileVersion || header.slotBytes != slotBytes || slotCount == 0
+        || (slotCount & (slotCount - 1)) != 0
+        || slotCount > (data.size () - headerBytes) / slotBytes) {
+      LOG_E_STREAM << "Flight recorder: " << path << " is not a recorder file" << std::endl;
+      return false;
+    }
+
+    // A writer still running claims slots while the file is read; the ones it may have been
+    // overwriting meanwhile are older than the window read again after the copy
+    FileHeader again = header;
+    file.clear ();
+    file.seekg (0);
+    file.read (reinterpret_cast<char*> (&again), sizeof (again));
+    const std::uint64_t next = header.next;
+    const std::uint64_t nextAfter = std::max (next, again.next);
+    const std::uint64_t oldest = nextAfter > slotCount ? nextAfter - slotCount : 0;
+
+    log.rules = unpackRules (header.rules);
+    log.state = static_cast<RunState> (again.state);
+    log.signal = again.signal;
+    log.startUnixMs = header.startUnixMs;
+    log.slotCount = slotCount;
+    log.written = nextAfter;
+
+    std::vector<Record> records;
+    records.reserve (static_cast<std::size_t> (next > oldest ? next - oldest : 0));
+    std::uint64_t lineContinues = 0; // sequence of the next piece of the last log line
+    for (std::uint64_t sequence = oldest; sequence < next; sequence++) {
+      Slot slot;
+      std::memcpy (&slot, data.data () + headerBytes + (sequence & (slotCount - 1)) * slotBytes,
+                   sizeof (slot));
+      if (slot.sequence != sequence + 1 || slot.length > payloadBytes) {
+        log.tornSlots++;
+        continue;
+      }
+      const RecordType type = static_cast<RecordType> (slot.type);
+      if (type == RecordType::Log || type == RecordType::LogContinued) {
+        const std::size_t skip = type == RecordType::Log ? logHeaderBytes : 0;
+        const std::string text (reinterpret_cast<const char*> (slot.payload) + skip,
+                                slot.length - std::min<std::size_t> (slot.length, skip));
+        if (type == RecordType::Log)
+          log.logs.push_back (LogLine{ sequence, slot.timeMs, slot.payload[0], text });
+        else if (!log.logs.empty () && lineContinues == sequence)
+          log.logs.back ().text += text;
+        lineContinues = sequence + 1;
+        continue;
+      }
+      Record record{};
+      record.sequence = sequence;
+      record.timeMs = slot.timeMs;
+      record.type = type;
+      std::memcpy (record.payload.data (), slot.payload, slot.length);
+      records.push_back (record);
+    }
+    log.records = std::move (records);
+    return true;
+  }
+
+  namespace {
+    SnapshotRecord snapshotOf (const dotname::Simulation& simulation) {
+      SnapshotRecord record{};
+      record.tick = simulation.tick;
+      record.ballX = simulation.ball.position.x;
+      record.ballY = simulation.ball.position.y;
+      record.ballSpeedX = simulation.ball.speed.x;
+      record.ballSpeedY = simulation.ball.speed.y;
+      record.paddleY = simulation.player.position.y;
+      record.score = simulation.score;
+      record.life = simulation.player.life;
+      record.ballActive = simulation.ball.active;
+      record.gameOver = simulation.gameOver;
+      return record;
+    }
+
+    void load (dotname::Simulation& simulation, const SnapshotRecord& record) {
+      simulation.Reset ();
+      simulation.tick = record.tick;
+      simulation.ball.position = Vector2{ record.ballX, record.ballY };
+      simulation.ball.speed = Vector2{ record.ballSpeedX, record.ballSpeedY };
+      simulation.ball.active = record.ballActive;
+      simulation.player.position.y = record.paddleY;
+      simulation.player.life = record.life;
+      simulation.score = record.score;
+      simulation.gameOver = record.gameOver;
+    }
+
+    // Bit for bit: the recording and the replay run the same float code
+    bool sameState (const SnapshotRecord& a, const SnapshotRecord& b) {
+      return a.tick == b.tick && std::memcmp (&a.ballX, &b.ballX, sizeof (float) * 5) == 0
+             && a.score == b.score && a.life == b.life && a.ballActive == b.ballActive
+             && a.gameOver == b.gameOver;
+    }
+  } // namespace
+
+  ReplaySummary replay (const FlightLog& log) {
+    ReplaySummary summary;
+    dotname::Simulation simulation{ log.rules };
+    bool synced = false;
+    for (const Record& record : log.records) {
+      if (record.type == RecordType::Snapshot) {
+        const SnapshotRecord snapshot = payloadAs<SnapshotRecord> (record);
+        if (synced && simulation.tick == snapshot.tick) {
+          summary.checked++;
+          if (sameState (snapshotOf (simulation), snapshot))
+            continue;
+          if (summary.diverged++ == 0)
+            summary.firstDivergedTick = snapshot.tick;
+        }
+        load (simulation, snapshot);
+        synced = true;
+        summary.resyncs++;
+      } else if (record.type == RecordType::Input && synced) {
+        const InputRecord input = payloadAs<InputRecord> (record);
+        if (!input.stepped)
+          continue;
+        if (input.tick != simulation.tick) {
+          synced = false; // inputs missing, wait for the next snapshot
+          continue;
+        }
+        dotname::PaddleInput paddle;
+        paddle.up = input.up;
+        paddle.down = input.down;
+        paddle.launch = input.launch;
+        simulation.Step (paddle);
+        summary.steps++;
+      }
+    }
+    summary.last = snapshotOf (simulation);
+    return summary;
+  }
+
+} // namespace FlightRecorder
@@ -0,0 +1,227 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Always on crash recorder: recent inputs, state, frame timings and log lines in a mapped file
+
+#ifndef FLIGHTRECORDER_HPP
+#define FLIGHTRECORDER_HPP
+
+#include <GameEngine/Simulation.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace FlightRecorder {
+
+  // The file is a header followed by a ring of fixed 64 byte slots, mapped shared so every
+  // store lands in the page cache: whatever happens to the process, the last slots written
+  // are in the file, and a hung process can be read while it still runs. Writers claim slots
+  // with one atomic add and publish each slot by storing its sequence number last.
+  constexpr std::size_t slotBytes = 64;
+  constexpr std::size_t payloadBytes = 48;
+  constexpr std::size_t headerBytes = 4096;
+  constexpr char fileMagic[] = "PONGFDR1";
+  // Ticks between state snapshots; replay steps the recorded inputs from one to the next
+  constexpr std::uint64_t snapshotInterval = 30;
+
+  enum class RecordType : std::uint16_t { Input = 1, Snapshot, Frame, Log, LogContinued, Marker };
+  // Signal: a fatal signal or exception; Interrupted: SIGINT or SIGTERM, a shutdown asked for
+  // from outside that did not get to close () the recorder
+  enum class Marker : std::uint8_t { Started = 1, Stopped, Signal, Interrupted };
+  enum class RunState : std::uint32_t { Running = 1, Stopped, Crashed, Interrupted };
+
+  struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t slotBytes;
+    std::uint64_t slotCount; // power of two
+    std::uint64_t startUnixMs;
+    std::int32_t rules[10]; // dotname::Rules in declaration order, for replay
+    std::uint32_t state;    // RunState, written atomically
+    std::int32_t signal;    // or exception code, once crashed or interrupted
+    std::uint64_t next;     // sequence of the next slot to claim, written atomically
+  };
+
+  struct Slot {
+    std::uint64_t sequence; // 0 while being written, else claim order + 1
+    std::uint16_t type;     // RecordType
+    std::uint16_t length;   // payload bytes used
+    std::uint32_t timeMs;   // since the recorder was opened
+    std::uint8_t payload[payloadBytes];
+  };
+  static_assert (sizeof (Slot) == slotBytes, "slots are one cache line");
+
+  // Controls the simulation stepped with, or a pause/restart key press without a step
+  struct InputRecord {
+    std::uint64_t tick; // before the step
+    float up;
+    float down;
+    std::uint8_t launch;
+    std::uint8_t stepped;
+    std::uint8_t pause;
+    std::uint8_t restart;
+  };
+
+  // Exact float state, enough to resume a headless simulation from
+  struct SnapshotRecord {
+    std::uint64_t tick;
+    float ballX;
+    float ballY;
+    float ballSpeedX;
+    float ballSpeedY;
+    float paddleY;
+    std::int32_t score;
+    std::int32_t life;
+    std::uint8_t ballActive;
+    std::uint8_t gameOver;
+    std::uint8_t paused;
+  };
+
+  struct FrameRecord {
+    std::uint64_t frame;
+    float intervalMs;
+    float updateMs;
+    float drawMs;
+    float renderScale;
+    std::uint32_t targetFps; // 0 while idle
+  };
+
+  struct MarkerRecord {
+    std::uint8_t marker; // Marker
+    std::int32_t signal;
+  };
+
+  static_assert (sizeof (InputRecord) <= payloadBytes && sizeof (SnapshotRecord) <= payloadBytes
+                     && sizeof (FrameRecord) <= payloadBytes,
+                 "records fit one slot");
+
+  class FlightRecorder {
+  public:
+    FlightRecorder () = default;
+    // close (), recording a clean stop
+    ~FlightRecorder ();
+
+    FlightRecorder (const FlightRecorder&) = delete;
+    FlightRecorder& operator= (const FlightRecorder&) = delete;
+
+    // Creates (or truncates) path sized for about seconds of 120 Hz frames and maps it.
+    // False with a logged reason when the file cannot be created or mapped.
+    bool open (const std::filesystem::path& path, double seconds, const dotname::Rules& rules);
+    void close ();
+    bool isOpen () const {
+      return header_ != nullptr;
+    }
+
+    // Makes this the recorder fatal signals (POSIX) or unhandled exceptions (Windows) are
+    // noted in before the process dies, and copies log lines into it. The handler runs on an
+    // alternate stack only on the calling thread: a stack overflow on another thread (audio
+    // mixer, exporters, telemetry writer) kills the process without a record.
+    void attachProcess ();
+
+    // Lock free and safe from any thread; records from a signal handler too
+    void input (std::uint64_t tick, const dotname::PaddleInput& paddle, bool stepped,
+                bool pause, bool restart);
+    template <typename Simulation> void snapshot (const Simulation& simulation, bool paused) {
+      using Traits = typename Simulation::Traits;
+      const Vector2 ball = Traits::toVector2 (simulation.ball.position);
+      const Vector2 speed = Traits::toVector2 (simulation.ball.speed);
+      SnapshotRecord record{};
+      record.tick = simulation.tick;
+      record.ballX = ball.x;
+      record.ballY = ball.y;
+      record.ballSpeedX = speed.x;
+      record.ballSpeedY = speed.y;
+      record.paddleY = Traits::toVector2 (simulation.player.position).y;
+      record.score = simulation.score;
+      record.life = simulation.player.life;
+      record.ballActive = simulation.ball.active;
+      record.gameOver = simulation.gameOver;
+      record.paused = paused;
+      write (RecordType::Snapshot, &record, sizeof (record));
+    }
+    void frame (const FrameRecord& record) {
+      write (RecordType::Frame, &record, sizeof (record));
+    }
+    // Lines longer than a few slots are cut
+    void log (int level, const char* text, std::size_t length);
+    void marker (Marker marker, int signal = 0);
+    // From the crash handler: marks the file crashed with the signal or exception code
+    void crashed (int signal);
+    // From the handler of SIGINT and SIGTERM: marks the file interrupted with the signal
+    void interrupted (int signal);
+
+  private:
+    void write (RecordType type, const void* payload, std::size_t length);
+    void writeSlot (std::uint64_t sequence, RecordType type, const void* payload,
+                    std::size_t length);
+    std::uint32_t elapsedMs () const;
+
+    FileHeader* header_ = nullptr;
+    Slot* slots_ = nullptr;
+    std::uint64_t mask_ = 0;
+    std::size_t mappedBytes_ = 0;
+    std::chrono::steady_clock::time_point start_;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+  };
+
+  // Decoded contents of a recorder file, oldest first
+  struct Record {
+    std::uint64_t sequence;
+    std::uint32_t timeMs;
+    RecordType type;
+    std::array<std::uint8_t, payloadBytes> payload;
+  };
+
+  struct LogLine {
+    std::uint64_t sequence;
+    std::uint32_t timeMs;
+    int level;
+    std::string text;
+  };
+
+  struct FlightLog {
+    dotname::Rules rules;
+    RunState state = RunState::Running;
+    int signal = 0;
+    std::uint64_t startUnixMs = 0;
+    std::uint64_t slotCount = 0;
+    std::uint64_t written = 0; // slots claimed over the whole run
+    std::vector<Record> records; // inputs, snapshots, frames and markers
+    std::vector<LogLine> logs;
+    std::uint64_t tornSlots = 0; // claimed but not complete, e.g. interrupted by the crash
+  };
+
+  // Reads a recorder file, also one a running process is still writing
+  bool read (const std::filesystem::path& path, FlightLog& log);
+
+  template <typename T> T payloadAs (const Record& record) {
+    T value;
+    std::memcpy (&value, record.payload.data (), sizeof (T));
+    return value;
+  }
+
+  struct ReplaySummary {
+    std::uint64_t steps = 0;       // inputs replayed
+    std::uint64_t checked = 0;     // snapshots compared with the replayed state
+    std::uint64_t diverged = 0;    // of those, how many differed
+    std::uint64_t firstDivergedTick = 0;
+    std::uint64_t resyncs = 0;     // restarts from a snapshot (start, new game, gap)
+    SnapshotRecord last{};         // replayed state at the end
+  };
+
+  // Steps a headless simulation with the recorded inputs from the oldest snapshot and checks
+  // it against every later snapshot, resuming from the recording after a mismatch or gap
+  ReplaySummary replay (const FlightLog& log);
+
+} // namespace FlightRecorder
+
+#endif // FLIGHTRECORDER_HPP
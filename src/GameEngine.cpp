@@ -2,7 +2,20 @@
 // Copyright (c) 2024-2025 Tomáš Mark
 
 #include <GameEngine/GameEngine.hpp>
+#include <GameEngine/EngineGroup.hpp>
+#include <Effects/Particles.hpp>
+#include <FlightRecorder/FlightRecorder.hpp>
+#include <Input/InputPipeline.hpp>
 #include <Logger/Logger.hpp>
+#include <Memory/FrameArena.hpp>
+#include <Metrics/Metrics.hpp>
+#include <Render/DrawList.hpp>
+#include <Render/ResolutionScaler.hpp>
+#include <Runtime/SharedResources.hpp>
+#include <Spectator/SpectatorServer.hpp>
+#include <Telemetry/Telemetry.hpp>
+#include <Timeline/Timeline.hpp>
+#include <Timing/FramePacer.hpp>
 #include <Utils/Utils.hpp>
 
 #include <math.h>
@@ -10,11 +23,13 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include <array>
+#include <cmath>
+#include <ctime>
 #include <filesystem>
 #include <iostream>
 #include <random>
 #include <string>
-#include <thread>
 #include <vector>
 
 #if defined(PLATFORM_WEB)
@@ -23,65 +38,156 @@
 
 namespace dotname {
 
-  GameEngine::GameEngine () {
+  namespace {
+    constexpr std::size_t particleCapacity = 8192;
+    // Draw commands besides the particles: paddles, ball, bricks and text
+    constexpr std::size_t sceneDrawCommands = 1024;
+    // Note progressions overlap when a game ends and the next starts within a second
+    constexpr std::size_t timelineCapacity = 32;
+    constexpr std::chrono::steady_clock::duration tickLength
+        = std::chrono::duration_cast<std::chrono::steady_clock::duration> (
+            std::chrono::duration<double> (1.0 / ticksPerSecond));
+    // Ticks caught up in one frame (at 30 fps a frame takes 4); after a longer stall the
+    // game skips ahead instead of fast forwarding through it
+    constexpr int maxTicksPerFrame = 8;
+  } // namespace
+
+  GameEngine::GameEngine ()
+      : frameArena_ (std::make_unique<Memory::FrameArena> ()), random_ (std::random_device{}()),
+        metrics_ (std::make_unique<Metrics::EngineMetrics> ()),
+        input_ (std::make_unique<Input::InputPipeline> ()),
+        drawList_ (std::make_unique<Render::DrawList> (particleCapacity + sceneDrawCommands)),
+        particles_ (std::make_unique<Effects::ParticlePool> (particleCapacity)),
+        timeline_ (std::make_unique<Timeline::Scheduler> ()) {
+    timeline_->reserve (timelineCapacity);
+    progressionCDur_ = Arpeggio ({ 0, 4, 7, 12, 16, 19, 24, 28, 31, 36, 40, 43 });
+    progressionCMinor_ = Arpeggio ({ 0, 3, 7, 10, 12, 15, 19, 22, 24, 27, 31, 34, 36, 39, 43, 46 });
+    progressionCMinorReversed_
+        = Arpeggio ({ 46, 43, 39, 36, 34, 31, 27, 24, 22, 19, 15, 12, 10, 7, 3, 0 });
     LOG_D_STREAM << libName_ << " ...constructed" << std::endl;
   }
-  GameEngine::GameEngine (const std::filesystem::path& assetsPath) : GameEngine () {
-    assetsPath_ = assetsPath;
-    if (!assetsPath_.empty ()) {
-      LOG_D_STREAM << "Assets path: " << assetsPath_ << std::endl;
-      // Initialization (Note windowTitle is unused on Android)
-      //---------------------------------------------------------
-      InitWindow (screenWidth, screenHeight, "classic game: pong");
-
-      Vector2 mainMonitorPosition = GetMonitorPosition (0);
-      SetWindowPosition (mainMonitorPosition.x + (GetMonitorWidth (0) - GetScreenWidth ()) / 2,
-                         mainMonitorPosition.y + (GetMonitorHeight (0) - GetScreenHeight ()) / 2);
-
-      // get current working directory modern c++
-      std::filesystem::path path = std::filesystem::current_path ();
-      std::cout << "Current path is : " << path << std::endl;
-
-      InitAudioDevice ();
-
-      AudioSample c1, cis1, d1, dis1, e1, f1, fis1, g1, gis1, a1, ais1, b1, c2, cis2, d2, dis2, e2,
-          f2, fis2, g2, gis2, a2, ais2, b2, c3, cis3, d3, dis3, e3, f3, fis3, g3, gis3, a3, ais3,
-          b3, c4, cis4, d4, dis4, e4, f4, fis4, g4, gis4, a4, ais4, b4;
-
-      notes = { c1, cis1, d1, dis1, e1, f1, fis1, g1, gis1, a1, ais1, b1,
-                c2, cis2, d2, dis2, e2, f2, fis2, g2, gis2, a2, ais2, b2,
-                c3, cis3, d3, dis3, e3, f3, fis3, g3, gis3, a3, ais3, b3,
-                c4, cis4, d4, dis4, e4, f4, fis4, g4, gis4, a4, ais4, b4 };
-
-      InitNotes (notes);
-
+  GameEngine::GameEngine (const std::filesystem::path& assetsPath, const EngineConfig& config)
+      : GameEngine () {
+    if (!Init (assetsPath, config))
+      return;
+    EngineGroup group (config_);
+    group.add (*this);
 #if defined(PLATFORM_WEB)
-      emscripten_set_main_loop (UpdateDrawFrame, 60, 1);
+    emscripten_set_main_loop_arg ([] (void* arg) { static_cast<EngineGroup*> (arg)->tick (); },
+                                  &group, 60, 1);
 #else
-      SetTargetFPS (120);
-      //--------------------------------------------------------------------------------------
-
-      // Main game loop
-      while (!WindowShouldClose ()) // Detect window close button or ESC key
-      {
-        // Update and Draw
-        //----------------------------------------------------------------------------------
-        UpdateDrawFrame ();
-        //----------------------------------------------------------------------------------
-      }
+    group.run ();
 #endif
-      // De-Initialization
-      //--------------------------------------------------------------------------------------
-      UnloadGame (); // Unload loaded data (textures, sounds, models...)
+    Shutdown ();
+  }
+  GameEngine::~GameEngine () {
+    Shutdown ();
+    LOG_D_STREAM << libName_ << " ...destructed" << std::endl;
+  }
 
-      CloseWindow (); // Close window and OpenGL context
-                      //-----------------------------------------------------------------
-    } else {
+  bool GameEngine::Init (const std::filesystem::path& assetsPath, const EngineConfig& config) {
+    Shutdown ();
+    assetsPath_ = assetsPath;
+    config_ = config;
+    if (assetsPath_.empty ()) {
       LOG_D_STREAM << "Assets path is empty" << std::endl;
+      return false;
+    }
+    LOG_D_STREAM << "Assets path: " << assetsPath_ << std::endl;
+    platform_ = Runtime::Platform::acquire (screenWidth, screenHeight, "classic game: pong");
+
+    // get current working directory modern c++
+    std::filesystem::path path = std::filesystem::current_path ();
+    std::cout << "Current path is : " << path << std::endl;
+
+    Render::ScalingConfig scaling;
+    scaling.dynamic = config_.renderScale <= 0.0f;
+    scaling.maxScale = scaling.dynamic ? 1.0f : config_.renderScale;
+    scaling.minScale = config_.minRenderScale;
+    scaler_ = std::make_unique<Render::ResolutionScaler> (screenWidth, screenHeight, scaling);
+    input_ = std::make_unique<Input::InputPipeline> (config_.wasdKeys ? Input::KeyLayout::Wasd
+                                                                      : Input::KeyLayout::Arrows);
+
+    InitNotes ();
+
+    if (!config_.metricsEndpoint.empty ()) {
+      metricsServer_ = std::make_unique<Metrics::MetricsServer> (*metrics_);
+      if (!metricsServer_->start (config_.metricsEndpoint)) {
+        metricsServer_.reset ();
+      }
+    }
+    if (!config_.spectatorEndpoint.empty ()) {
+      spectator_ = std::make_unique<Spectator::SpectatorServer> ();
+      if (!spectator_->start (config_.spectatorEndpoint)) {
+        spectator_.reset ();
+      }
+    }
+    if (!config_.telemetryPath.empty ()) {
+      telemetryWriter_ = std::make_unique<Telemetry::TelemetryWriter> ();
+      if (telemetryWriter_->open (config_.telemetryPath)) {
+        telemetry_ = std::make_unique<Telemetry::TelemetryRecorder> (*telemetryWriter_);
+      } else {
+        telemetryWriter_.reset ();
+      }
+    }
+    if (!config_.flightRecorderPath.empty ()) {
+      flightRecorder_ = std::make_unique<FlightRecorder::FlightRecorder> ();
+      if (flightRecorder_->open (config_.flightRecorderPath, config_.flightRecorderSeconds,
+                                 rules)) {
+        flightRecorder_->attachProcess ();
+        flightRecorder_->snapshot (simulation, pause);
+      } else {
+        flightRecorder_.reset ();
+      }
     }
+    game_ = 0;
+    metrics_->gamesStarted.add ();
+    return true;
   }
-  GameEngine::~GameEngine () {
-    LOG_D_STREAM << libName_ << " ...destructed" << std::endl;
+
+  void GameEngine::Shutdown (void) {
+    if (!platform_)
+      return;
+    const Input::LatencySummary latency = GetInputLatency ();
+    if (latency.samples > 0) {
+      LOG_I_FMT ("Input poll to submit over {} presses: mean {:.2f} ms, p50 {:.2f} ms, "
+                 "p95 {:.2f} ms, max {:.2f} ms, {} events dropped",
+                 latency.samples, latency.mean * 1e3, latency.p50 * 1e3, latency.p95 * 1e3,
+                 latency.max * 1e3, input_->queue ().dropped ());
+    }
+    const Render::ScalingStats& scalingStats = scaler_->stats ();
+    LOG_I_FMT ("Render scale: {:.3f} ({}x{}) at exit, lowest {:.3f}, {} changes",
+               scalingStats.scale, scalingStats.width, scalingStats.height,
+               scalingStats.lowestScale, scalingStats.changes);
+
+    if (spectator_) {
+      const Spectator::SpectatorStats spectatorStats = spectator_->stats ();
+      LOG_I_FMT ("Spectators: {} frames ({} keyframes), {:.1f} bytes/tick published, "
+                 "{} bytes sent to {} spectators, {} resynced, {} dropped",
+                 spectatorStats.frames, spectatorStats.keyframes,
+                 spectatorStats.frames > 0 ? static_cast<double> (spectatorStats.bytesPublished)
+                                                 / spectatorStats.frames
+                                           : 0.0,
+                 spectatorStats.bytesSent, spectatorStats.accepted, spectatorStats.resyncs,
+                 spectatorStats.dropped);
+    }
+
+    if (telemetryWriter_) {
+      telemetry_.reset (); // hands over the last chunk
+      telemetryWriter_->close ();
+      const Telemetry::WriterStats telemetryStats = telemetryWriter_->stats ();
+      LOG_I_FMT ("Telemetry: {} events of {} games in {} bytes, {} stalls", telemetryStats.rows,
+                 game_ + 1, telemetryStats.bytes, telemetryStats.stalls);
+      telemetryWriter_.reset ();
+    }
+
+    timeline_->clear ();
+    UnloadGame ();
+    scaler_.reset ();
+    metricsServer_.reset ();
+    spectator_.reset ();
+    flightRecorder_.reset (); // marks the recording as stopped cleanly
+    platform_.reset (); // the last engine closes the window and audio device
   }
 
   //------------------------------------------------------------------------------------
@@ -94,328 +200,399 @@ namespace dotname {
 
     // brickSize = (Vector2){(float)GetScreenWidth() / BRICKS_PER_LINE, 40.0f};
 
-    // Initialize player
-    player.position = Vector2{ 57, static_cast<float> (screenHeight / 2) };
-    player.size = Vector2{ 14, static_cast<float> (screenHeight / 6) };
-    player.life = PLAYER_MAX_LIFE;
-
-    // Initialize ball
-    ball.position = Vector2{ player.position.x + ball.radius,
-                             player.position.y - (player.size.y / 2) - ball.radius };
-
-    ball.speed = Vector2{ 0, 0 };
-    ball.radius = 7;
-    ball.active = false;
-  }
-
-  // Update game (one frame)
-  void GameEngine::UpdateGame (void) {
-    if (!gameOver) {
-      if (IsKeyPressed ('P'))
-        pause = !pause;
-
-      if (!pause) {
-        // Player movement logic
-        if (IsKeyDown (KEY_UP))
-          player.position.y -= 5;
-        if ((player.position.y - (player.size.y / 2)) <= 0)
-          player.position.y = (player.size.y / 2);
-
-        if (IsKeyDown (KEY_DOWN))
-          player.position.y += 5;
-        if ((player.position.y + player.size.y / 2) >= screenHeight)
-          player.position.y = screenHeight - (player.size.y / 2);
-
-        // Ball launching logic
-        if (!ball.active) {
-          if (IsKeyPressed (KEY_SPACE)) {
-            ball.active = true;
-            ball.speed = Vector2{ 5, 0 };
-          }
-        }
+    simulation.Reset ();
+    metrics_->gamesStarted.add ();
+    game_++;
+    PublishState (GameEvents{});
+    if (flightRecorder_)
+      flightRecorder_->snapshot (simulation, pause);
+  }
 
-        // Ball movement logic
-        if (ball.active) {
-          ball.position.x += ball.speed.x;
-          ball.position.y += ball.speed.y;
-        } else {
-          ball.position = Vector2{ player.position.x + (ball.radius * 2), player.position.y };
+  // Update game (one frame). The simulation steps every tick of 1 / ticksPerSecond that
+  // started by the key poll, with the keys of that tick, so the game runs at the same speed
+  // at any frame rate: 2 steps in a 60 fps frame, 1 at 120 fps, none in some 240 fps frames.
+  void GameEngine::UpdateGame (const Input::PressedKeys& pressed) {
+    // Keys were polled at the end of the previous frame; the ticks run up to that poll
+    const auto polled = pressed.time != Input::Clock::time_point{} ? pressed.time : lastFrameStart_;
+    input_->poll (polled, pressed);
+
+    if (simulation.gameOver || pause) {
+      // Time spent waiting is not caught up later
+      nextTick_ = polled;
+      const Input::FrameInput input = input_->consume (polled, frameLength_);
+      if (simulation.gameOver) {
+        if (input.restart) {
+          if (flightRecorder_)
+            flightRecorder_->input (simulation.tick, input.paddle, false, false, true);
+          InitGame ();
         }
+        return;
+      }
+      if (!input.pause)
+        return;
+      pause = false;
+      if (flightRecorder_)
+        flightRecorder_->input (simulation.tick, input.paddle, false, true, false);
+    }
 
-        // Collision logic: ball vs walls
-        if ((ball.position.x + ball.radius) >= screenWidth) {
-          ball.speed.x *= -1;
-          PlayRandomNoteInCMinorProgression ();
-        }
+    if (nextTick_ == std::chrono::steady_clock::time_point{})
+      nextTick_ = polled;
+    else if (polled - nextTick_ > tickLength * maxTicksPerFrame)
+      nextTick_ = polled - tickLength * (maxTicksPerFrame - 1);
+    while (nextTick_ <= polled && !simulation.gameOver) {
+      const Input::FrameInput input = input_->consume (nextTick_, tickLength);
+      nextTick_ += tickLength;
+      if (input.pause) {
+        pause = true;
+        if (flightRecorder_)
+          flightRecorder_->input (simulation.tick, input.paddle, false, true, false);
+        break;
+      }
+      if (flightRecorder_)
+        flightRecorder_->input (simulation.tick, input.paddle, true, false, false);
+      const GameEvents& events = simulation.Step (input.paddle);
+      RecordEvents (events);
+      PublishState (events);
+      if (telemetry_)
+        telemetry_->record (game_, simulation, events);
+      if (flightRecorder_
+          && (simulation.tick % FlightRecorder::snapshotInterval == 0 || simulation.gameOver))
+        flightRecorder_->snapshot (simulation, pause);
+      PlayEventSounds (events);
+      SpawnEventEffects (events);
+    }
+    if (!pause)
+      particles_->update (std::chrono::duration<float> (frameLength_).count ());
+  }
 
-        if (ball.active && (ball.position.x - ball.radius) <= 0) {
-          ball.speed = Vector2{ 0, 0 };
-          PlayRandomNoteInCMinorProgression ();
-          ball.active = false;
-          player.life--;
-          // PlayProgressionCMinor();
-          PlayProgressionCMinorReversed ();
-        }
+  void GameEngine::RecordEvents (const GameEvents& events) {
+    for (const GameEvent& event : events) {
+      switch (event.type) {
+      case GameEventType::WallBounce:
+        metrics_->wallBounces.add ();
+        break;
+      case GameEventType::PaddleHit:
+        metrics_->paddleHits.add ();
+        break;
+      case GameEventType::BallLost:
+        metrics_->ballsLost.add ();
+        break;
+      case GameEventType::GameOver:
+        metrics_->gamesOver.add ();
+        break;
+      }
+    }
+    metrics_->score.set (simulation.score);
+  }
 
-        if (((ball.position.y - ball.radius) <= 0
-             || ((ball.position.y + ball.radius) >= screenHeight))) {
-          ball.speed.y *= -1;
-          PlayRandomNoteInCMinorProgression ();
-        }
+  void GameEngine::PublishState (const GameEvents& events) {
+    if (!spectator_)
+      return;
+    const auto now = std::chrono::steady_clock::now ().time_since_epoch ();
+    spectator_->publish (Spectator::capture (
+        simulation, events,
+        static_cast<std::uint64_t> (
+            std::chrono::duration_cast<std::chrono::microseconds> (now).count ())));
+  }
 
-        // Collision logic: ball vs player
-        if (CheckCollisionCircleRec (ball.position, ball.radius,
-                                     Rectangle{ player.position.x - (player.size.x / 2),
-                                                player.position.y - (player.size.y / 2),
-                                                player.size.x, player.size.y })) {
-          if (ball.speed.x < 0) {
-            ball.speed.x *= -1;
-            ball.speed.y = (ball.position.y - player.position.y) / (player.size.y / 2) * 5;
-            PlayRandomNoteInCMinorProgression ();
-            score++;
-          }
-        }
+  void GameEngine::PlayEventSounds (const GameEvents& events) {
+    for (const GameEvent& event : events) {
+      switch (event.type) {
+      case GameEventType::WallBounce:
+      case GameEventType::PaddleHit:
+        PlayRandomNoteInCMinorProgression ();
+        break;
+      case GameEventType::BallLost:
+        PlayRandomNoteInCMinorProgression ();
+        // PlayProgressionCMinor();
+        PlayProgressionCMinorReversed ();
+        break;
+      case GameEventType::GameOver:
+        break;
+      }
+    }
+  }
 
-        // Game over logic
-        if (player.life <= 0)
-          gameOver = true;
-
-        else {
-          // gameOver = true;
-
-          // for (int i = 0; i < LINES_OF_BRICKS; i++)
-          // {
-          //     for (int j = 0; j < BRICKS_PER_LINE; j++)
-          //     {
-          //         if (brick[i][j].active)
-          //             // gameOver = false;
-          //     }
-          // }
-        }
+  void GameEngine::SpawnEventEffects (const GameEvents& events) {
+    const Vector2 centre = { screenWidth / 2.0f, screenHeight / 2.0f };
+    for (const GameEvent& event : events) {
+      Effects::EmitterSettings settings;
+      switch (event.type) {
+      case GameEventType::WallBounce: {
+        // Spray back into the court
+        const Vector2 away = { centre.x - event.position.x, centre.y - event.position.y };
+        const float length = std::sqrt (away.x * away.x + away.y * away.y);
+        settings.direction = length > 0 ? Vector2{ away.x / length, away.y / length } : away;
+        settings.spread = 0.9f;
+        settings.color = GRAY;
+        particles_->emit (event.position, 16, settings);
+        break;
       }
-    } else {
-      if (IsKeyPressed (KEY_ENTER)) {
-        InitGame ();
-        gameOver = false;
+      case GameEventType::PaddleHit:
+        settings.direction = Vector2{ 1.0f, 0.0f };
+        settings.spread = 1.1f;
+        settings.maxSpeed = 320.0f;
+        settings.color = DARKGRAY;
+        particles_->emit (event.position, 32, settings);
+        break;
+      case GameEventType::BallLost:
+        settings.maxSpeed = 420.0f;
+        settings.lifetime = 1.2f;
+        settings.color = RED;
+        particles_->emit (event.position, 240, settings);
+        break;
+      case GameEventType::GameOver:
+        break;
       }
     }
   }
 
   // Draw game (one frame)
   void GameEngine::DrawGame (void) {
-    BeginDrawing ();
+    const Player& player = simulation.player;
+    const Ball& ball = simulation.ball;
+    Render::DrawList& draw = *drawList_;
+
+    // Everything below is in court units, independent of the window and render resolution
+    scaler_->begin (RAYWHITE);
 
-    ClearBackground (RAYWHITE);
+    if (config_.stressEntities > 0)
+      DrawStressEntities ();
 
-    if (!gameOver) {
+    if (!simulation.gameOver) {
       // Draw player bar with unified coordinates
-      DrawRectangle (player.position.x - player.size.x / 2, player.position.y - player.size.y / 2,
-                     player.size.x, player.size.y, BLACK);
+      draw.rectangle (Rectangle{ player.position.x - player.size.x / 2,
+                                 player.position.y - player.size.y / 2, player.size.x,
+                                 player.size.y },
+                      BLACK);
 
-      std::string scoreStr = "Score:\t" + std::to_string (score);
-      DrawText (scoreStr.c_str (), 10, 10, 20, MAROON);
+      draw.text (frameArena_->format ("Score:\t{}", simulation.score), 10, 10, 20, MAROON);
 
       // Draw player lives
       for (int i = 0; i < player.life; i++)
-        DrawText ("*", screenWidth - 100 - (40 * i), screenHeight - 40, 40, MAROON);
+        draw.text ("*", screenWidth - 100 - (40 * i), screenHeight - 40, 40, MAROON);
 
       // Draw ball
-      DrawCircleV (ball.position, ball.radius, MAROON);
+      draw.circle (ball.position, ball.radius, MAROON);
+
+      particles_->draw (draw);
 
       if (pause)
-        DrawText ("GAME PAUSED", screenWidth / 2 - MeasureText ("GAME PAUSED", 40) / 2,
-                  screenHeight / 2 - 40, 40, GRAY);
+        draw.text ("GAME PAUSED", screenWidth / 2 - MeasureText ("GAME PAUSED", 40) / 2,
+                   screenHeight / 2 - 40, 40, GRAY, 1);
     } else
-      DrawText ("PRESS [ENTER] TO PLAY AGAIN",
-                GetScreenWidth () / 2 - MeasureText ("PRESS [ENTER] TO PLAY AGAIN", 20) / 2,
-                GetScreenHeight () / 2 - 50, 20, GRAY);
+      draw.text ("PRESS [ENTER] TO PLAY AGAIN",
+                 screenWidth / 2 - MeasureText ("PRESS [ENTER] TO PLAY AGAIN", 20) / 2,
+                 screenHeight / 2 - 50, 20, GRAY);
+
+    draw.submit ();
+    scaler_->end ();
+    metrics_->drawCommands.set (static_cast<double> (draw.stats ().commands));
+    metrics_->drawEstimatedBatches.set (static_cast<double> (draw.stats ().estimatedBatches));
+  }
 
-    EndDrawing ();
+  // Animated filler shapes behind the game to load the batching path
+  void GameEngine::DrawStressEntities (void) {
+    static constexpr std::array<Color, 4> palette
+        = { Color{ 230, 180, 180, 255 }, Color{ 180, 200, 230, 255 }, Color{ 190, 225, 190, 255 },
+            Color{ 225, 215, 170, 255 } };
+    const float time = static_cast<float> (GetTime ());
+    const float width = static_cast<float> (screenWidth);
+    const float height = static_cast<float> (screenHeight);
+    for (int i = 0; i < config_.stressEntities; i++) {
+      const float x = std::fmod (i * 37.0f + time * (40.0f + (i % 7) * 15.0f), width);
+      const float y = std::fmod (i * 53.0f + time * (30.0f + (i % 5) * 20.0f), height);
+      const Color color = palette[i % palette.size ()];
+      if (i % 2 == 0)
+        drawList_->rectangle (Rectangle{ x, y, 6, 6 }, color, -1);
+      else
+        drawList_->circle (Vector2{ x, y }, 4, color, -1);
+    }
   }
 
   // Unload game variables
   void GameEngine::UnloadGame (void) {
-    // TODO: Unload all dynamic loaded data (textures, sounds, models...)
+    bank_.reset (); // unloaded with the last engine using it
+  }
+
+  void GameEngine::Update (const Input::PressedKeys& pressed) {
+    using Seconds = std::chrono::duration<double>;
+    const auto frameStart = std::chrono::steady_clock::now ();
+    if (metrics_->frames.value () > 0) {
+      frameLength_ = frameStart - lastFrameStart_;
+      metrics_->frameSeconds.observe (Seconds (frameLength_).count ());
+    }
+    lastFrameStart_ = frameStart;
+    timeline_->advance (frameLength_);
+
+    frameArena_->reset ();
+    const std::uint64_t allocationsBefore = Memory::threadAllocationCount ();
+    UpdateGame (pressed);
+    pendingAllocations_ = Memory::threadAllocationCount () - allocationsBefore;
+    updateLength_ = std::chrono::steady_clock::now () - frameStart;
+    metrics_->updateSeconds.observe (Seconds (updateLength_).count ());
+  }
+
+  void GameEngine::Render (void) {
+    const auto drawStart = std::chrono::steady_clock::now ();
+    const std::uint64_t allocationsBefore = Memory::threadAllocationCount ();
+    DrawGame ();
+    pendingAllocations_ += Memory::threadAllocationCount () - allocationsBefore;
+    drawLength_ = std::chrono::steady_clock::now () - drawStart;
+  }
+
+  void GameEngine::Present (Rectangle area) {
+    const auto presentStart = std::chrono::steady_clock::now ();
+    scaler_->present (area);
+    lastSubmit_ = std::chrono::steady_clock::now ();
+    drawLength_ += lastSubmit_ - presentStart;
+    const double inputLatency = input_->frameSubmitted (lastSubmit_);
+    if (inputLatency >= 0.0)
+      metrics_->inputPollToSubmitSeconds.observe (inputLatency);
+  }
+
+  bool GameEngine::IsIdle () const {
+    return (pause || simulation.gameOver) && config_.stressEntities == 0
+           && timeline_->stats ().running == 0;
+  }
+
+  void GameEngine::FrameDone (const Timing::PacingStats& pacing) {
+    using Seconds = std::chrono::duration<double>;
+    TrackFrameAllocations (pendingAllocations_);
+    pendingAllocations_ = 0;
+    metrics_->drawSeconds.observe (Seconds (drawLength_).count ());
+    metrics_->frames.add ();
+
+    // The scale only changes the render cost, so that is what is held to the frame budget
+    if (!pacing.idle && pacing.targetFps > 0)
+      scaler_->frameDone (Seconds (drawLength_).count (), 1.0 / pacing.targetFps);
+    metrics_->renderScale.set (scaler_->stats ().scale);
+    metrics_->targetFps.set (pacing.idle ? 0.0 : pacing.targetFps);
+    metrics_->framesSkipped.set (static_cast<double> (pacing.framesSkipped));
+    metrics_->workSecondsSaved.set (pacing.cpuSecondsSaved);
+
+    if (config_.stressEntities > 0 && metrics_->frames.value () % 600 == 0) {
+      const Render::DrawStats& stats = drawList_->stats ();
+      LOG_I_FMT ("Draw: {} commands, {} vertices in {} estimated batches at {} fps",
+                 stats.commands, stats.vertices, stats.estimatedBatches, GetFPS ());
+    }
+    metrics_->audioVoices.set (bank_ ? static_cast<double> (bank_->samples ().activeVoices ())
+                                     : 0.0);
+    metrics_->audioResidentBytes.set (static_cast<double> (GetAudioResidentBytes ()));
+
+    if (flightRecorder_) {
+      using Milliseconds = std::chrono::duration<float, std::milli>;
+      FlightRecorder::FrameRecord frame{};
+      frame.frame = metrics_->frames.value ();
+      frame.intervalMs = Milliseconds (frameLength_).count ();
+      frame.updateMs = Milliseconds (updateLength_).count ();
+      frame.drawMs = Milliseconds (drawLength_).count ();
+      frame.renderScale = scaler_->stats ().scale;
+      frame.targetFps = pacing.idle ? 0 : static_cast<std::uint32_t> (pacing.targetFps);
+      flightRecorder_->frame (frame);
+    }
   }
 
   // Update and Draw (one frame)
   void GameEngine::UpdateDrawFrame (void) {
-    UpdateGame ();
-    DrawGame ();
+    Update (Input::PressedKeys::collect ());
+    Render ();
+    BeginDrawing ();
+    ClearBackground (BLACK);
+    Present (Rectangle{ 0, 0, static_cast<float> (GetScreenWidth ()),
+                        static_cast<float> (GetScreenHeight ()) });
+    EndDrawing ();
+    Timing::PacingStats pacing;
+    pacing.targetFps = config_.targetFps;
+    FrameDone (pacing);
+  }
+
+  void GameEngine::TrackFrameAllocations (std::uint64_t allocations) {
+    frameAllocations_ = allocations;
+    if (!config_.reportAllocations || !Memory::trackingEnabled ())
+      return;
+
+    windowFrames_++;
+    windowAllocations_ += allocations;
+    windowAllocatingFrames_ += allocations > 0 ? 1 : 0;
+    windowWorstFrame_ = std::max (windowWorstFrame_, allocations);
+    if (windowFrames_ < 600)
+      return;
+
+    // Logged outside the measured window, the log line itself allocates
+    LOG_I_FMT ("Heap allocations: {} in {} frames, {} frames allocated, worst frame {}, "
+               "arena high water {} bytes",
+               windowAllocations_, windowFrames_, windowAllocatingFrames_, windowWorstFrame_,
+               frameArena_->highWater ());
+    windowFrames_ = windowAllocations_ = windowAllocatingFrames_ = windowWorstFrame_ = 0;
   }
 
-  void GameEngine::InitNotes (std::vector<AudioSample>& notes) {
-    notes[0].sound = LoadSound ((assetsPath_ / "C1.wav").string ().c_str ());
-
-    notes[1].sound = LoadSound ((assetsPath_ / "C#1.wav").string ().c_str ());
-    notes[2].sound = LoadSound ((assetsPath_ / "D1.wav").string ().c_str ());
-    notes[3].sound = LoadSound ((assetsPath_ / "D#1.wav").string ().c_str ());
-    notes[4].sound = LoadSound ((assetsPath_ / "E1.wav").string ().c_str ());
-    notes[5].sound = LoadSound ((assetsPath_ / "F1.wav").string ().c_str ());
-    notes[6].sound = LoadSound ((assetsPath_ / "F#1.wav").string ().c_str ());
-    notes[7].sound = LoadSound ((assetsPath_ / "G1.wav").string ().c_str ());
-    notes[8].sound = LoadSound ((assetsPath_ / "G#1.wav").string ().c_str ());
-    notes[9].sound = LoadSound ((assetsPath_ / "A1.wav").string ().c_str ());
-    notes[10].sound = LoadSound ((assetsPath_ / "A#1.wav").string ().c_str ());
-    notes[11].sound = LoadSound ((assetsPath_ / "B1.wav").string ().c_str ());
-
-    notes[12].sound = LoadSound ((assetsPath_ / "C2.wav").string ().c_str ());
-    notes[13].sound = LoadSound ((assetsPath_ / "C#2.wav").string ().c_str ());
-    notes[14].sound = LoadSound ((assetsPath_ / "D2.wav").string ().c_str ());
-    notes[15].sound = LoadSound ((assetsPath_ / "D#2.wav").string ().c_str ());
-    notes[16].sound = LoadSound ((assetsPath_ / "E2.wav").string ().c_str ());
-    notes[17].sound = LoadSound ((assetsPath_ / "F2.wav").string ().c_str ());
-    notes[18].sound = LoadSound ((assetsPath_ / "F#2.wav").string ().c_str ());
-    notes[19].sound = LoadSound ((assetsPath_ / "G2.wav").string ().c_str ());
-    notes[20].sound = LoadSound ((assetsPath_ / "G#2.wav").string ().c_str ());
-    notes[21].sound = LoadSound ((assetsPath_ / "A2.wav").string ().c_str ());
-    notes[22].sound = LoadSound ((assetsPath_ / "A#2.wav").string ().c_str ());
-    notes[23].sound = LoadSound ((assetsPath_ / "B2.wav").string ().c_str ());
-
-    notes[24].sound = LoadSound ((assetsPath_ / "C3.wav").string ().c_str ());
-    notes[25].sound = LoadSound ((assetsPath_ / "C#3.wav").string ().c_str ());
-    notes[26].sound = LoadSound ((assetsPath_ / "D3.wav").string ().c_str ());
-    notes[27].sound = LoadSound ((assetsPath_ / "D#3.wav").string ().c_str ());
-    notes[28].sound = LoadSound ((assetsPath_ / "E3.wav").string ().c_str ());
-    notes[29].sound = LoadSound ((assetsPath_ / "F3.wav").string ().c_str ());
-    notes[30].sound = LoadSound ((assetsPath_ / "F#3.wav").string ().c_str ());
-    notes[31].sound = LoadSound ((assetsPath_ / "G3.wav").string ().c_str ());
-    notes[32].sound = LoadSound ((assetsPath_ / "G#3.wav").string ().c_str ());
-    notes[33].sound = LoadSound ((assetsPath_ / "A3.wav").string ().c_str ());
-    notes[34].sound = LoadSound ((assetsPath_ / "A#3.wav").string ().c_str ());
-    notes[35].sound = LoadSound ((assetsPath_ / "B3.wav").string ().c_str ());
-
-    notes[36].sound = LoadSound ((assetsPath_ / "C4.wav").string ().c_str ());
-    notes[37].sound = LoadSound ((assetsPath_ / "C#4.wav").string ().c_str ());
-    notes[38].sound = LoadSound ((assetsPath_ / "D4.wav").string ().c_str ());
-    notes[39].sound = LoadSound ((assetsPath_ / "D#4.wav").string ().c_str ());
-    notes[40].sound = LoadSound ((assetsPath_ / "E4.wav").string ().c_str ());
-    notes[41].sound = LoadSound ((assetsPath_ / "F4.wav").string ().c_str ());
-    notes[42].sound = LoadSound ((assetsPath_ / "F#4.wav").string ().c_str ());
-    notes[43].sound = LoadSound ((assetsPath_ / "G4.wav").string ().c_str ());
-    notes[44].sound = LoadSound ((assetsPath_ / "G#4.wav").string ().c_str ());
-    notes[45].sound = LoadSound ((assetsPath_ / "A4.wav").string ().c_str ());
-    notes[46].sound = LoadSound ((assetsPath_ / "A#4.wav").string ().c_str ());
-    notes[47].sound = LoadSound ((assetsPath_ / "B4.wav").string ().c_str ());
+  void GameEngine::InitNotes () {
+    Runtime::BankKey key;
+    key.assetsPath = assetsPath_;
+    key.cacheDirectory = config_.cacheDirectory;
+    key.storage = config_.compressedSamples ? Audio::SampleBank::Storage::Adpcm
+                                            : Audio::SampleBank::Storage::Pcm;
+    bank_ = Runtime::ResourceBank::acquire (key, platform_);
+  }
+
+  void GameEngine::PlayNote (std::size_t index) {
+    if (bank_) {
+      bank_->samples ().play (index);
+    }
+  }
+
+  Input::LatencySummary GameEngine::GetInputLatency () const {
+    return input_->latency ().summary ();
+  }
+
+  std::size_t GameEngine::GetAudioResidentBytes () const {
+    return bank_ ? bank_->samples ().residentBytes () : 0;
   }
 
   void GameEngine::PlayRandomNote () {
-    // modern c++ random number generation
-    std::random_device rd;
-    std::mt19937 gen (rd ());
     std::uniform_int_distribution<> dis (0, 47); // 48 notes
-    int randomNote = dis (gen);
-    PlaySound (notes[randomNote].sound);
+    int randomNote = dis (random_);
+    PlayNote (randomNote);
   }
 
   void GameEngine::PlayRandomNoteInCMinorProgression () {
-    std::vector<int> cMinorProgression
+    static constexpr std::array<int, 16> cMinorProgression
         = { 0, 3, 7, 10, 12, 15, 19, 22, 24, 27, 31, 34, 36, 39, 43, 46 };
-    std::random_device rd;
-    std::mt19937 gen (rd ());
     std::uniform_int_distribution<> dis (0, 15); // 16 notes
-    int randomNote = dis (gen);
-    PlaySound (notes[cMinorProgression[randomNote]].sound);
+    int randomNote = dis (random_);
+    PlayNote (cMinorProgression[randomNote]);
   }
 
   void GameEngine::PlayCDur () {
-    PlaySound (notes[0].sound);
-    PlaySound (notes[4].sound);
-    PlaySound (notes[7].sound);
+    PlayNote (0);
+    PlayNote (4);
+    PlayNote (7);
   }
 
+  // Note progressions are timelines with the notes 50 ms apart: they return at once and
+  // play on from Update ()
   void GameEngine::PlayProgressionCDur () {
-    PlaySound (notes[0].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[4].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[7].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[12].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[16].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[19].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[24].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[28].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[31].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[36].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[40].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[43].sound);
+    timeline_->start (progressionCDur_);
   }
 
   void GameEngine::PlayProgressionCMinor () {
-    PlaySound (notes[0].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[3].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[7].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[10].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[12].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[15].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[19].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[22].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[24].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[27].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[31].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[34].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[36].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[39].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[43].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[46].sound);
+    timeline_->start (progressionCMinor_);
   }
 
   void GameEngine::PlayProgressionCMinorReversed () {
-    PlaySound (notes[46].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[43].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[39].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[36].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[34].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[31].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[27].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[24].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[22].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[19].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[15].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[12].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[10].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[7].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[3].sound);
-    std::this_thread::sleep_for (std::chrono::milliseconds (50));
-    PlaySound (notes[0].sound);
+    timeline_->start (progressionCMinorReversed_);
+  }
+
+  std::shared_ptr<const Timeline::Sequence> GameEngine::Arpeggio (const std::vector<int>& notes) {
+    auto sequence = std::make_shared<Timeline::Sequence> ();
+    for (std::size_t i = 0; i < notes.size (); i++) {
+      if (i > 0)
+        sequence->wait (std::chrono::milliseconds (50));
+      const std::size_t note = static_cast<std::size_t> (notes[i]);
+      sequence->call ([this, note] (std::uint64_t) { PlayNote (note); });
+    }
+    return sequence;
   }
 
 } // namespace dotname
\ No newline at end of file
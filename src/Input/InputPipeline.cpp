@@ -0,0 +1,139 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Key events stamped when polled, sub-frame paddle integration and poll to submit latency
+
+#include "InputPipeline.hpp"
+
+#include <algorithm>
+
+#include <raylib.h>
+
+namespace Input {
+
+  namespace {
+    // Indexed by Action
+    constexpr std::array<int, actionCount> arrowKeys
+        = { KEY_UP, KEY_DOWN, KEY_SPACE, KEY_P, KEY_ENTER };
+    constexpr std::array<int, actionCount> wasdKeys = { KEY_W, KEY_S, KEY_D, KEY_Q, KEY_E };
+
+    constexpr std::size_t up = static_cast<std::size_t> (Action::Up);
+    constexpr std::size_t down = static_cast<std::size_t> (Action::Down);
+  } // namespace
+
+  LatencySummary LatencyStats::summary () const {
+    LatencySummary result;
+    result.samples = count_;
+    if (count_ == 0)
+      return result;
+
+    std::array<double, window> sorted = samples_;
+    double sum = 0.0;
+    for (std::size_t i = 0; i < count_; i++) {
+      sum += sorted[i];
+    }
+    std::sort (sorted.begin (), sorted.begin () + count_);
+    result.mean = sum / count_;
+    result.p50 = sorted[count_ / 2];
+    result.p95 = sorted[std::min (count_ - 1, count_ * 95 / 100)];
+    result.max = sorted[count_ - 1];
+    return result;
+  }
+
+  PressedKeys PressedKeys::collect () {
+    PressedKeys pressed;
+    pressed.time = Clock::now ();
+    for (int key = GetKeyPressed (); key != 0; key = GetKeyPressed ()) {
+      if (pressed.count < capacity)
+        pressed.keys[pressed.count++] = key;
+    }
+    return pressed;
+  }
+
+  InputPipeline::InputPipeline (KeyLayout layout)
+      : keys_ (layout == KeyLayout::Wasd ? wasdKeys : arrowKeys) {
+  }
+
+  void InputPipeline::poll (Clock::time_point now, const PressedKeys& pressed) {
+    const Clock::duration sinceLast
+        = lastPoll_ == Clock::time_point{} ? Clock::duration::zero () : now - lastPoll_;
+    lastPoll_ = now;
+
+    // raylib keeps every press in a queue, even when the key is up again by now
+    std::array<bool, actionCount> queuedPress{};
+    for (std::size_t k = 0; k < pressed.count; k++) {
+      for (std::size_t i = 0; i < actionCount; i++) {
+        if (keys_[i] == pressed.keys[k])
+          queuedPress[i] = true;
+      }
+    }
+
+    for (std::size_t i = 0; i < actionCount; i++) {
+      const Action action = static_cast<Action> (i);
+      const bool isDown = IsKeyDown (keys_[i]);
+      if (isDown != polledDown_[i]) {
+        queue_.push (InputEvent{ action, isDown, now });
+      } else if (!isDown && queuedPress[i]) {
+        queue_.push (InputEvent{ action, true, now - sinceLast / 2 });
+        queue_.push (InputEvent{ action, false, now });
+      }
+      polledDown_[i] = isDown;
+    }
+  }
+
+  FrameInput InputPipeline::consume (Clock::time_point tickStart, Clock::duration tickLength) {
+    FrameInput input;
+    const Clock::time_point tickEnd = tickStart + tickLength;
+    std::array<Clock::duration, 2> heldFor{};
+    std::array<Clock::time_point, 2> heldSince{ tickStart, tickStart };
+
+    InputEvent event;
+    while (const InputEvent* next = queue_.peek ()) {
+      if (next->time >= tickEnd && tickLength > Clock::duration::zero ())
+        break; // belongs to a later tick
+      queue_.pop (event);
+      const std::size_t index = static_cast<std::size_t> (event.action);
+
+      if (index == up || index == down) {
+        // Only a tap is dated before the tick; a key not held yet counts from the press
+        const Clock::time_point at = held_[index] ? std::max (event.time, tickStart) : event.time;
+        if (held_[index])
+          heldFor[index] += at - heldSince[index];
+        heldSince[index] = at;
+      }
+      if (event.pressed) {
+        input.paddle.launch |= event.action == Action::Launch;
+        input.pause |= event.action == Action::Pause;
+        input.restart |= event.action == Action::Restart;
+        const Clock::time_point polled = std::max (event.time, tickStart);
+        if (!pendingPress_ || polled < oldestPress_)
+          oldestPress_ = polled;
+        pendingPress_ = true;
+      }
+      held_[index] = event.pressed;
+    }
+
+    for (std::size_t i : { up, down }) {
+      if (held_[i])
+        heldFor[i] += tickEnd - heldSince[i];
+    }
+    auto fraction = [&] (std::size_t i) {
+      if (tickLength <= Clock::duration::zero ())
+        return held_[i] ? 1.0f : 0.0f;
+      return std::min (1.0f, std::chrono::duration<float> (heldFor[i]).count ()
+                                 / std::chrono::duration<float> (tickLength).count ());
+    };
+    input.paddle.up = fraction (up);
+    input.paddle.down = fraction (down);
+    return input;
+  }
+
+  double InputPipeline::frameSubmitted (Clock::time_point now) {
+    if (!pendingPress_)
+      return -1.0;
+    pendingPress_ = false;
+    const double seconds = std::chrono::duration<double> (now - oldestPress_).count ();
+    latency_.record (seconds);
+    return seconds;
+  }
+
+} // namespace Input
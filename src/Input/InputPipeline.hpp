@@ -0,0 +1,165 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Key events stamped when polled, sub-frame paddle integration and poll to submit latency
+
+#ifndef INPUTPIPELINE_HPP
+#define INPUTPIPELINE_HPP
+
+#include <GameEngine/Simulation.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Input {
+
+  using Clock = std::chrono::steady_clock;
+
+  enum class Action : std::uint8_t { Up, Down, Launch, Pause, Restart, Count };
+  constexpr std::size_t actionCount = static_cast<std::size_t> (Action::Count);
+
+  struct InputEvent {
+    Action action;
+    bool pressed;
+    Clock::time_point time;
+  };
+
+  // Fixed capacity FIFO, events that do not fit are counted and dropped
+  class InputQueue {
+  public:
+    static constexpr std::size_t capacity = 128;
+
+    bool push (const InputEvent& event) {
+      if (count_ == capacity) {
+        dropped_++;
+        return false;
+      }
+      events_[(head_ + count_++) % capacity] = event;
+      return true;
+    }
+    bool pop (InputEvent& event) {
+      if (count_ == 0)
+        return false;
+      event = events_[head_];
+      head_ = (head_ + 1) % capacity;
+      count_--;
+      return true;
+    }
+    const InputEvent* peek () const {
+      return count_ > 0 ? &events_[head_] : nullptr;
+    }
+    std::size_t size () const {
+      return count_;
+    }
+    std::uint64_t dropped () const {
+      return dropped_;
+    }
+
+  private:
+    std::array<InputEvent, capacity> events_{};
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;
+    std::uint64_t dropped_ = 0;
+  };
+
+  struct LatencySummary {
+    std::size_t samples = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double max = 0.0;
+  };
+
+  // Rolling window over the most recent samples (seconds)
+  class LatencyStats {
+  public:
+    static constexpr std::size_t window = 512;
+
+    void record (double seconds) {
+      samples_[next_] = seconds;
+      next_ = (next_ + 1) % window;
+      if (count_ < window)
+        count_++;
+    }
+    LatencySummary summary () const;
+
+  private:
+    std::array<double, window> samples_{};
+    std::size_t next_ = 0;
+    std::size_t count_ = 0;
+  };
+
+  // Key presses drained from raylib's queue once per frame. The queue empties on read, so
+  // engines sharing the keyboard must share one collection.
+  struct PressedKeys {
+    static constexpr std::size_t capacity = 32;
+    std::array<int, capacity> keys{};
+    std::size_t count = 0;
+    // When collect () ran: raylib polls the keyboard at the end of EndDrawing (), so this is
+    // right after the poll, and after the wait when the loop slept until input
+    Clock::time_point time{};
+
+    static PressedKeys collect ();
+  };
+
+  // Arrows, space, P and enter; or W/S, D to launch, Q to pause and E to restart
+  enum class KeyLayout : std::uint8_t { Arrows, Wasd };
+
+  // Controls for one frame; paddle up/down carry the fraction of the tick the key was held
+  struct FrameInput {
+    dotname::PaddleInput paddle;
+    bool pause = false;
+    bool restart = false;
+  };
+
+  class InputPipeline {
+  public:
+    explicit InputPipeline (KeyLayout layout = KeyLayout::Arrows);
+
+    // Reads the keyboard once and queues every transition since the previous poll, stamped
+    // with the poll time: raylib reports no event times, so a transition is only known to
+    // have happened since the previous poll. Key presses released again before the poll
+    // (taps shorter than a frame) come from raylib's key queue and are dated half the
+    // interval back, a press with half a frame of hold ending at the poll.
+    void poll (Clock::time_point now, const PressedKeys& pressed);
+    void poll () {
+      const PressedKeys pressed = PressedKeys::collect ();
+      poll (pressed.time, pressed);
+    }
+    // Queue an event from another source (replay, automation)
+    void push (const InputEvent& event) {
+      queue_.push (event);
+    }
+
+    // Consumes the events up to the end of the tick [tickStart, tickStart + tickLength); the
+    // hold of a tap dated before tickStart counts into this tick
+    FrameInput consume (Clock::time_point tickStart, Clock::duration tickLength);
+
+    // Call when the frame built from the last consume () is submitted. Records the time from
+    // the poll that saw the oldest press it consumed and returns it in seconds, or a negative
+    // value if none. This is the engine's share of the latency: the wait for the poll (up to
+    // a frame) and the display's scanout come on top of it.
+    double frameSubmitted (Clock::time_point now);
+
+    const LatencyStats& latency () const {
+      return latency_;
+    }
+    const InputQueue& queue () const {
+      return queue_;
+    }
+
+  private:
+    std::array<int, actionCount> keys_;
+    InputQueue queue_;
+    LatencyStats latency_;
+    std::array<bool, actionCount> polledDown_{};
+    std::array<bool, actionCount> held_{};
+    Clock::time_point lastPoll_{};
+    Clock::time_point oldestPress_{};
+    bool pendingPress_ = false;
+  };
+
+} // namespace Input
+
+#endif // INPUTPIPELINE_HPP
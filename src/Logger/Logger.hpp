@@ -5,7 +5,10 @@
 #ifndef LOGGER_HPP
 #define LOGGER_HPP
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -66,6 +69,7 @@ private:
   std::mutex logMutex_;
   std::ostringstream messageStream_;
   std::ofstream logFile_;
+  std::atomic<std::uint64_t> messageCount_{ 0 };
 
 protected:
   Logger () = default;
@@ -91,6 +95,8 @@ public:
 
 private:
   Level currentLevel_ = Level::LOG_INFO;
+  void (*tap_) (void*, Level, const char*, std::size_t) = nullptr;
+  void* tapContext_ = nullptr;
 
 public:
   void debug (const std::string& message, const std::string& caller = "") {
@@ -115,6 +121,7 @@ public:
 
   void log (Level level, const std::string& message, const std::string& caller = "") {
     std::lock_guard<std::mutex> lock (logMutex_);
+    messageCount_.fetch_add (1, std::memory_order_relaxed);
     auto now = std::chrono::system_clock::now ();
     auto now_time = std::chrono::system_clock::to_time_t (now);
     std::tm now_tm;
@@ -135,6 +142,25 @@ public:
       logFile_ << "[" << (caller.empty () ? "empty caller" : caller) << "] ";
       logFile_ << "[" << levelToString (level) << "] " << message << std::endl;
     }
+    if (tap_)
+      tap_ (tapContext_, level, message.data (), message.size ());
+  }
+
+  // Receives every message as it is logged, under the log lock, e.g. to keep the recent lines
+  // in a crash recorder. One tap at a time.
+  using Tap = void (*) (void* context, Level level, const char* message, std::size_t length);
+  void setTap (Tap tap, void* context) {
+    std::lock_guard<std::mutex> lock (logMutex_);
+    tap_ = tap;
+    tapContext_ = context;
+  }
+  // Removes the tap if it is still the one installed with context
+  void clearTap (void* context) {
+    std::lock_guard<std::mutex> lock (logMutex_);
+    if (tapContext_ == context) {
+      tap_ = nullptr;
+      tapContext_ = nullptr;
+    }
   }
 
   template <typename... Args>
@@ -145,6 +171,11 @@ public:
   }
 
 public:
+  // Messages written so far, readable without taking the log lock
+  std::uint64_t messageCount () const {
+    return messageCount_.load (std::memory_order_relaxed);
+  }
+
   bool enableFileLogging (const std::string& filename) {
     std::lock_guard<std::mutex> lock (logMutex_);
     try {
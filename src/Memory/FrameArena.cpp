@@ -0,0 +1,117 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Frame scoped bump allocator and heap allocation tracking
+
+#include "FrameArena.hpp"
+
+#include <cstdlib>
+
+namespace Memory {
+
+#ifdef GAMEENGINE_ALLOCATION_TRACKING
+  namespace {
+    // Per thread, so audio or worker threads do not show up in game thread frames
+    thread_local std::uint64_t allocationCount = 0;
+  }
+
+  bool trackingEnabled () {
+    return true;
+  }
+  std::uint64_t threadAllocationCount () {
+    return allocationCount;
+  }
+
+  namespace detail {
+    void* trackedAllocate (std::size_t size, std::size_t alignment, bool nothrow) {
+      allocationCount++;
+      if (size == 0)
+        size = 1;
+      void* memory = nullptr;
+      if (alignment <= alignof (std::max_align_t)) {
+        memory = std::malloc (size);
+      } else {
+  #ifdef _WIN32
+        memory = _aligned_malloc (size, alignment);
+  #else
+        if (posix_memalign (&memory, alignment, size) != 0)
+          memory = nullptr;
+  #endif
+      }
+      if (memory == nullptr && !nothrow)
+        throw std::bad_alloc ();
+      return memory;
+    }
+
+    void trackedFree (void* memory, std::size_t alignment) {
+  #ifdef _WIN32
+      if (alignment > alignof (std::max_align_t)) {
+        _aligned_free (memory);
+        return;
+      }
+  #else
+      (void)alignment;
+  #endif
+      std::free (memory);
+    }
+  } // namespace detail
+#else
+  bool trackingEnabled () {
+    return false;
+  }
+  std::uint64_t threadAllocationCount () {
+    return 0;
+  }
+#endif
+
+} // namespace Memory
+
+#ifdef GAMEENGINE_ALLOCATION_TRACKING
+// Global replacements; they live in this object file, which the engine always links in
+// through the functions above.
+using Memory::detail::trackedAllocate;
+using Memory::detail::trackedFree;
+constexpr std::size_t defaultAlignment = alignof (std::max_align_t);
+
+void* operator new (std::size_t size) {
+  return trackedAllocate (size, defaultAlignment, false);
+}
+void* operator new[] (std::size_t size) {
+  return trackedAllocate (size, defaultAlignment, false);
+}
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept {
+  return trackedAllocate (size, defaultAlignment, true);
+}
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept {
+  return trackedAllocate (size, defaultAlignment, true);
+}
+void* operator new (std::size_t size, std::align_val_t alignment) {
+  return trackedAllocate (size, static_cast<std::size_t> (alignment), false);
+}
+void* operator new[] (std::size_t size, std::align_val_t alignment) {
+  return trackedAllocate (size, static_cast<std::size_t> (alignment), false);
+}
+void operator delete (void* memory) noexcept {
+  trackedFree (memory, defaultAlignment);
+}
+void operator delete[] (void* memory) noexcept {
+  trackedFree (memory, defaultAlignment);
+}
+void operator delete (void* memory, std::size_t) noexcept {
+  trackedFree (memory, defaultAlignment);
+}
+void operator delete[] (void* memory, std::size_t) noexcept {
+  trackedFree (memory, defaultAlignment);
+}
+void operator delete (void* memory, std::align_val_t alignment) noexcept {
+  trackedFree (memory, static_cast<std::size_t> (alignment));
+}
+void operator delete[] (void* memory, std::align_val_t alignment) noexcept {
+  trackedFree (memory, static_cast<std::size_t> (alignment));
+}
+void operator delete (void* memory, std::size_t, std::align_val_t alignment) noexcept {
+  trackedFree (memory, static_cast<std::size_t> (alignment));
+}
+void operator delete[] (void* memory, std::size_t, std::align_val_t alignment) noexcept {
+  trackedFree (memory, static_cast<std::size_t> (alignment));
+}
+#endif
@@ -0,0 +1,124 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Frame scoped bump allocator and heap allocation tracking
+
+#ifndef FRAMEARENA_HPP
+#define FRAMEARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "fmt/core.h"
+
+namespace Memory {
+
+  // Counts operator new calls made by the calling thread. Real counts need the library built
+  // with ENABLE_ALLOCATION_TRACKING, otherwise trackingEnabled () is false and counts stay 0.
+  bool trackingEnabled ();
+  std::uint64_t threadAllocationCount ();
+
+  // Linear allocator for data that lives for one frame. The buffer is allocated once and
+  // reset() makes all of it available again, so per frame scratch never reaches the heap.
+  class FrameArena {
+  public:
+    explicit FrameArena (std::size_t capacity = 64 * 1024)
+        : buffer_ (std::make_unique<std::byte[]> (capacity)), capacity_ (capacity) {
+    }
+
+    FrameArena (const FrameArena&) = delete;
+    FrameArena& operator= (const FrameArena&) = delete;
+
+    // nullptr when the arena is exhausted for this frame (counted in overflows ())
+    void* allocate (std::size_t size, std::size_t alignment = alignof (std::max_align_t)) {
+      const std::size_t start = (used_ + alignment - 1) & ~(alignment - 1);
+      if (start + size > capacity_) {
+        overflows_++;
+        return nullptr;
+      }
+      used_ = start + size;
+      return buffer_.get () + start;
+    }
+
+    template <typename T> T* allocateArray (std::size_t count) {
+      return static_cast<T*> (allocate (sizeof (T) * count, alignof (T)));
+    }
+
+    // Formats into arena memory; the text is valid until the next reset ()
+    template <typename... Args>
+    const char* format (fmt::format_string<Args...> format, Args&&... args) {
+      static constexpr std::size_t maxLength = 256;
+      char* text = allocateArray<char> (maxLength);
+      if (text == nullptr)
+        return "";
+      const auto result
+          = fmt::format_to_n (text, maxLength - 1, format, std::forward<Args> (args)...);
+      *result.out = '\0';
+      used_ -= maxLength - (result.out - text + 1); // give back the unused tail
+      return text;
+    }
+
+    void reset () {
+      highWater_ = std::max (highWater_, used_);
+      used_ = 0;
+    }
+
+    std::size_t capacity () const {
+      return capacity_;
+    }
+    std::size_t used () const {
+      return used_;
+    }
+    std::size_t highWater () const {
+      return std::max (highWater_, used_);
+    }
+    std::uint64_t overflows () const {
+      return overflows_;
+    }
+
+  private:
+    std::unique_ptr<std::byte[]> buffer_;
+    std::size_t capacity_;
+    std::size_t used_ = 0;
+    std::size_t highWater_ = 0;
+    std::uint64_t overflows_ = 0;
+  };
+
+  // Standard allocator adaptor so containers can live in a FrameArena for one frame
+  template <typename T> class ArenaAllocator {
+  public:
+    using value_type = T;
+
+    explicit ArenaAllocator (FrameArena& arena) : arena_ (&arena) {
+    }
+    template <typename U> ArenaAllocator (const ArenaAllocator<U>& other) : arena_ (other.arena_) {
+    }
+
+    T* allocate (std::size_t count) {
+      T* memory = arena_->allocateArray<T> (count);
+      if (memory == nullptr)
+        throw std::bad_alloc ();
+      return memory;
+    }
+    void deallocate (T*, std::size_t) {
+      // released all at once by FrameArena::reset ()
+    }
+
+    template <typename U> bool operator== (const ArenaAllocator<U>& other) const {
+      return arena_ == other.arena_;
+    }
+    template <typename U> bool operator!= (const ArenaAllocator<U>& other) const {
+      return arena_ != other.arena_;
+    }
+
+  private:
+    template <typename U> friend class ArenaAllocator;
+    FrameArena* arena_;
+  };
+
+} // namespace Memory
+
+#endif // FRAMEARENA_HPP
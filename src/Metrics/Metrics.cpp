@@ -0,0 +1,162 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Live engine counters and a localhost exporter in Prometheus text format
+
+#include "Metrics.hpp"
+
+#include <Logger/Logger.hpp>
+#include <Net/Socket.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+#include "fmt/core.h"
+
+namespace Metrics {
+
+  namespace {
+    void renderValue (std::string& out, const char* name, const char* type, const char* help,
+                      double value) {
+      out += fmt::format ("# HELP {} {}\n# TYPE {} {}\n{} {}\n", name, help, name, type, name,
+                          value);
+    }
+  } // namespace
+
+  constexpr std::array<double, 11> Histogram::bounds;
+
+  void Histogram::render (std::string& out, const char* name, const char* help) const {
+    out += fmt::format ("# HELP {} {}\n# TYPE {} histogram\n", name, help, name);
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < bounds.size (); i++) {
+      cumulative += buckets_[i].load (std::memory_order_relaxed);
+      out += fmt::format ("{}_bucket{{le=\"{}\"}} {}\n", name, bounds[i], cumulative);
+    }
+    cumulative += buckets_.back ().load (std::memory_order_relaxed);
+    out += fmt::format ("{}_bucket{{le=\"+Inf\"}} {}\n", name, cumulative);
+    out += fmt::format ("{}_sum {}\n{}_count {}\n", name,
+                        sumNanoseconds_.load (std::memory_order_relaxed) / 1e9, name, cumulative);
+  }
+
+  std::string EngineMetrics::render () const {
+    std::string out;
+    out.reserve (4096);
+    frameSeconds.render (out, "pong_frame_seconds", "Time between frame starts");
+    updateSeconds.render (out, "pong_update_seconds", "Input and simulation time per frame");
+    drawSeconds.render (out, "pong_draw_seconds",
+                        "Draw and present time per frame, without the buffer swap and pacing wait");
+    inputPollToSubmitSeconds.render (
+        out, "pong_input_poll_to_submit_seconds",
+        "Keyboard poll that saw a press to submit of the frame reflecting it, without the wait "
+        "for the poll");
+    renderValue (out, "pong_frames_total", "counter", "Frames rendered",
+                 static_cast<double> (frames.value ()));
+    renderValue (out, "pong_audio_active_voices", "gauge", "Voices playing in the mixer",
+                 audioVoices.value ());
+    renderValue (out, "pong_audio_resident_bytes", "gauge", "Bytes held by loaded samples",
+                 audioResidentBytes.value ());
+    renderValue (out, "pong_log_messages_total", "counter", "Log lines written",
+                 static_cast<double> (LOG.messageCount ()));
+    renderValue (out, "pong_draw_commands", "gauge", "Shapes and text recorded last frame",
+                 drawCommands.value ());
+    renderValue (out, "pong_draw_estimated_batches", "gauge",
+                 "Batches submitted last frame, estimated (not GL draw calls)",
+                 drawEstimatedBatches.value ());
+    renderValue (out, "pong_target_fps", "gauge", "Paced frame rate, 0 while idle",
+                 targetFps.value ());
+    renderValue (out, "pong_frames_skipped_total", "counter",
+                 "Frames the full rate would have drawn that pacing skipped",
+                 framesSkipped.value ());
+    renderValue (out, "pong_frame_work_saved_seconds_total", "counter",
+                 "Estimated update and draw time saved by pacing", workSecondsSaved.value ());
+    renderValue (out, "pong_render_scale", "gauge",
+                 "Internal render resolution as a share of the window", renderScale.value ());
+    renderValue (out, "pong_games_started_total", "counter", "Games started",
+                 static_cast<double> (gamesStarted.value ()));
+    renderValue (out, "pong_games_over_total", "counter", "Games finished",
+                 static_cast<double> (gamesOver.value ()));
+    renderValue (out, "pong_paddle_hits_total", "counter", "Ball returns by the paddle",
+                 static_cast<double> (paddleHits.value ()));
+    renderValue (out, "pong_wall_bounces_total", "counter", "Ball bounces off the walls",
+                 static_cast<double> (wallBounces.value ()));
+    renderValue (out, "pong_balls_lost_total", "counter", "Balls missed by the paddle",
+                 static_cast<double> (ballsLost.value ()));
+    renderValue (out, "pong_score", "gauge", "Score of the current game", score.value ());
+    return out;
+  }
+
+  MetricsServer::MetricsServer (const EngineMetrics& metrics) : metrics_ (metrics) {
+  }
+
+  MetricsServer::~MetricsServer () {
+    stop ();
+  }
+
+  bool MetricsServer::start (const std::string& endpoint) {
+    stop ();
+    const Net::Handle listener = Net::listen (endpoint, "Metrics", unixPath_);
+    if (listener == Net::invalidHandle)
+      return false;
+
+    listener_ = listener;
+    running_ = true;
+    thread_ = std::thread (&MetricsServer::serve, this);
+    LOG_I_STREAM << "Metrics exporter listening on " << endpoint << std::endl;
+    return true;
+  }
+
+  void MetricsServer::stop () {
+    if (!running_.exchange (false))
+      return;
+    thread_.join ();
+    Net::close (listener_, unixPath_);
+    listener_ = Net::invalidHandle;
+    unixPath_.clear ();
+  }
+
+  void MetricsServer::serve () {
+    while (running_) {
+      // Wake up regularly so stop () does not wait for a scrape
+      if (Net::pollReadable (listener_, 200) <= 0)
+        continue;
+      const Net::Handle client = Net::accept (listener_);
+      if (client == Net::invalidHandle)
+        continue;
+      respond (client);
+      Net::close (client);
+    }
+  }
+
+  void MetricsServer::respond (std::intptr_t client) {
+    char request[1024];
+    std::size_t received = 0;
+    // Only the request line matters; headers are read until the buffer fills or they end
+    while (received < sizeof (request) - 1 && Net::pollReadable (client, 1000) > 0) {
+      const long count
+          = Net::receive (client, request + received, sizeof (request) - 1 - received);
+      if (count <= 0)
+        break;
+      received += static_cast<std::size_t> (count);
+      request[received] = '\0';
+      if (std::strstr (request, "\r\n\r\n") != nullptr || std::strstr (request, "\n\n") != nullptr)
+        break;
+    }
+    request[received] = '\0';
+
+    const bool metrics = std::strncmp (request, "GET /metrics ", 13) == 0
+                         || std::strncmp (request, "GET / ", 6) == 0;
+    const std::string body = metrics ? metrics_.render () : std::string ("not found\n");
+    const std::string response = fmt::format (
+        "HTTP/1.0 {}\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: {}\r\n"
+        "Connection: close\r\n\r\n{}",
+        metrics ? "200 OK" : "404 Not Found", body.size (), body);
+
+    std::size_t sent = 0;
+    while (sent < response.size ()) {
+      const long count = Net::send (client, response.data () + sent, response.size () - sent);
+      if (count <= 0)
+        break;
+      sent += static_cast<std::size_t> (count);
+    }
+  }
+
+} // namespace Metrics
@@ -0,0 +1,121 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Live engine counters and a localhost exporter in Prometheus text format
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace Metrics {
+
+  // All updates are relaxed atomic stores/adds from the game thread; the exporter thread only
+  // reads, so publishing never blocks a frame.
+  class Counter {
+  public:
+    void add (std::uint64_t value = 1) {
+      value_.fetch_add (value, std::memory_order_relaxed);
+    }
+    std::uint64_t value () const {
+      return value_.load (std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<std::uint64_t> value_{ 0 };
+  };
+
+  class Gauge {
+  public:
+    void set (double value) {
+      value_.store (value, std::memory_order_relaxed);
+    }
+    double value () const {
+      return value_.load (std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<double> value_{ 0.0 };
+  };
+
+  // Fixed buckets sized around 60 / 120 Hz frame budgets
+  class Histogram {
+  public:
+    static constexpr std::array<double, 11> bounds
+        = { 0.001, 0.002, 0.004, 0.006, 0.00833, 0.0125, 0.01667, 0.025, 0.0333, 0.05, 0.1 };
+
+    void observe (double seconds) {
+      std::size_t bucket = 0;
+      while (bucket < bounds.size () && seconds > bounds[bucket]) {
+        bucket++;
+      }
+      buckets_[bucket].fetch_add (1, std::memory_order_relaxed);
+      sumNanoseconds_.fetch_add (static_cast<std::uint64_t> (seconds * 1e9),
+                                 std::memory_order_relaxed);
+    }
+
+    // Appends the _bucket/_sum/_count series for name
+    void render (std::string& out, const char* name, const char* help) const;
+
+  private:
+    std::array<std::atomic<std::uint64_t>, bounds.size () + 1> buckets_{}; // last is +Inf
+    std::atomic<std::uint64_t> sumNanoseconds_{ 0 };
+  };
+
+  struct EngineMetrics {
+    Histogram frameSeconds;        // time between frame starts
+    Histogram updateSeconds;       // input and simulation
+    Histogram drawSeconds;         // drawing and presenting, not EndDrawing's swap and pacing
+    Histogram inputPollToSubmitSeconds; // key poll to submit of the frame showing the press
+    Counter frames;
+    Gauge audioVoices;
+    Gauge audioResidentBytes;
+    Gauge drawCommands;
+    Gauge drawEstimatedBatches;
+    Gauge targetFps; // 0 while waiting for input
+    Gauge framesSkipped;
+    Gauge workSecondsSaved;
+    Gauge renderScale; // internal resolution as a share of the window
+    Counter gamesStarted;
+    Counter gamesOver;
+    Counter paddleHits;
+    Counter wallBounces;
+    Counter ballsLost;
+    Gauge score;
+
+    // Also reports the process wide count of log lines written
+    std::string render () const;
+  };
+
+  // Serves GET /metrics on 127.0.0.1:<port>, or on a Unix socket with "unix:<path>" (POSIX
+  // only), from its own thread.
+  class MetricsServer {
+  public:
+    explicit MetricsServer (const EngineMetrics& metrics);
+    ~MetricsServer ();
+
+    MetricsServer (const MetricsServer&) = delete;
+    MetricsServer& operator= (const MetricsServer&) = delete;
+
+    // False (with a logged reason) when the endpoint is invalid or cannot be bound
+    bool start (const std::string& endpoint);
+    void stop ();
+
+  private:
+    void serve ();
+    void respond (std::intptr_t client);
+
+    const EngineMetrics& metrics_;
+    std::atomic<bool> running_{ false };
+    std::intptr_t listener_ = -1;
+    std::string unixPath_;
+    std::thread thread_;
+  };
+
+} // namespace Metrics
+
+#endif // METRICS_HPP
@@ -0,0 +1,284 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Minimal stream socket layer (POSIX and Winsock) for the localhost servers
+
+#include "Socket.hpp"
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <winsock2.h>
+  #include <ws2tcpip.h>
+#else
+  #include <arpa/inet.h>
+  #include <fcntl.h>
+  #include <netinet/in.h>
+  #include <netinet/tcp.h>
+  #include <poll.h>
+  #include <sys/socket.h>
+  #include <sys/un.h>
+  #include <unistd.h>
+#endif
+
+#include <Logger/Logger.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <exception>
+
+namespace Net {
+
+  namespace {
+#ifdef _WIN32
+    using Socket = SOCKET;
+    const Socket invalidSocket = INVALID_SOCKET;
+    void closeSocket (Socket socket) {
+      closesocket (socket);
+    }
+    bool wouldBlock () {
+      return WSAGetLastError () == WSAEWOULDBLOCK;
+    }
+    constexpr int sendFlags = 0;
+#else
+    using Socket = int;
+    const Socket invalidSocket = -1;
+    void closeSocket (Socket socket) {
+      ::close (socket);
+    }
+    bool wouldBlock () {
+      return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+  #ifdef MSG_NOSIGNAL
+    constexpr int sendFlags = MSG_NOSIGNAL; // a closed peer must not raise SIGPIPE
+  #else
+    constexpr int sendFlags = 0;
+  #endif
+#endif
+
+    Socket native (Handle handle) {
+      return static_cast<Socket> (handle);
+    }
+
+    bool startup () {
+#ifdef _WIN32
+      WSADATA wsaData;
+      return WSAStartup (MAKEWORD (2, 2), &wsaData) == 0;
+#else
+      return true;
+#endif
+    }
+
+    void cleanup () {
+#ifdef _WIN32
+      WSACleanup ();
+#endif
+    }
+
+    bool isUnix (const std::string& endpoint) {
+      return endpoint.rfind ("unix:", 0) == 0;
+    }
+
+    int parsePort (const std::string& endpoint) {
+      int port = 0;
+      try {
+        port = std::stoi (endpoint);
+      } catch (const std::exception&) {
+        port = 0;
+      }
+      return port > 0 && port <= 65535 ? port : 0;
+    }
+
+    void disableSigPipe (Socket socket) {
+#if defined(SO_NOSIGPIPE)
+      int on = 1;
+      setsockopt (socket, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof (on));
+#else
+      (void)socket;
+#endif
+    }
+
+    // Small frames go out immediately instead of waiting to be coalesced
+    void disableNagle (Socket socket) {
+      int on = 1;
+      setsockopt (socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*> (&on),
+                  sizeof (on));
+    }
+  } // namespace
+
+  Handle listen (const std::string& endpoint, const char* owner, std::string& unixPath,
+                 int backlog) {
+    unixPath.clear ();
+    if (!startup ()) {
+      LOG_E_STREAM << owner << ": WSAStartup failed" << std::endl;
+      return invalidHandle;
+    }
+
+    Socket listener = invalidSocket;
+    if (isUnix (endpoint)) {
+#ifdef _WIN32
+      LOG_E_STREAM << owner << ": Unix sockets are not supported on this platform" << std::endl;
+      cleanup ();
+      return invalidHandle;
+#else
+      sockaddr_un address{};
+      const std::string path = endpoint.substr (5);
+      if (path.empty () || path.size () >= sizeof (address.sun_path)) {
+        LOG_E_STREAM << owner << ": invalid socket path " << path << std::endl;
+        return invalidHandle;
+      }
+      address.sun_family = AF_UNIX;
+      std::memcpy (address.sun_path, path.c_str (), path.size () + 1);
+      ::unlink (path.c_str ());
+      listener = ::socket (AF_UNIX, SOCK_STREAM, 0);
+      if (listener == invalidSocket
+          || ::bind (listener, reinterpret_cast<sockaddr*> (&address), sizeof (address)) != 0) {
+        LOG_E_STREAM << owner << ": cannot bind " << path << ": " << std::strerror (errno)
+                     << std::endl;
+        if (listener != invalidSocket)
+          closeSocket (listener);
+        return invalidHandle;
+      }
+      unixPath = path;
+#endif
+    } else {
+      const int port = parsePort (endpoint);
+      if (port == 0) {
+        LOG_E_STREAM << owner << ": invalid endpoint " << endpoint << std::endl;
+        cleanup ();
+        return invalidHandle;
+      }
+      sockaddr_in address{};
+      address.sin_family = AF_INET;
+      address.sin_port = htons (static_cast<std::uint16_t> (port));
+      address.sin_addr.s_addr = htonl (INADDR_LOOPBACK); // never exposed beyond the host
+      listener = ::socket (AF_INET, SOCK_STREAM, 0);
+      if (listener != invalidSocket) {
+        int reuse = 1;
+        setsockopt (listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*> (&reuse),
+                    sizeof (reuse));
+      }
+      if (listener == invalidSocket
+          || ::bind (listener, reinterpret_cast<sockaddr*> (&address), sizeof (address)) != 0) {
+        LOG_E_STREAM << owner << ": cannot bind 127.0.0.1:" << port << std::endl;
+        if (listener != invalidSocket)
+          closeSocket (listener);
+        cleanup ();
+        return invalidHandle;
+      }
+    }
+
+    if (::listen (listener, backlog) != 0) {
+      LOG_E_STREAM << owner << ": listen failed on " << endpoint << std::endl;
+      close (static_cast<Handle> (listener), unixPath);
+      unixPath.clear ();
+      return invalidHandle;
+    }
+    return static_cast<Handle> (listener);
+  }
+
+  Handle connect (const std::string& endpoint) {
+    if (!startup ())
+      return invalidHandle;
+    Socket socket = invalidSocket;
+    if (isUnix (endpoint)) {
+#ifndef _WIN32
+      sockaddr_un address{};
+      const std::string path = endpoint.substr (5);
+      if (!path.empty () && path.size () < sizeof (address.sun_path)) {
+        address.sun_family = AF_UNIX;
+        std::memcpy (address.sun_path, path.c_str (), path.size () + 1);
+        socket = ::socket (AF_UNIX, SOCK_STREAM, 0);
+        if (socket != invalidSocket
+            && ::connect (socket, reinterpret_cast<sockaddr*> (&address), sizeof (address))
+                   != 0) {
+          closeSocket (socket);
+          socket = invalidSocket;
+        }
+      }
+#endif
+    } else if (const int port = parsePort (endpoint)) {
+      sockaddr_in address{};
+      address.sin_family = AF_INET;
+      address.sin_port = htons (static_cast<std::uint16_t> (port));
+      address.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+      socket = ::socket (AF_INET, SOCK_STREAM, 0);
+      if (socket != invalidSocket
+          && ::connect (socket, reinterpret_cast<sockaddr*> (&address), sizeof (address)) != 0) {
+        closeSocket (socket);
+        socket = invalidSocket;
+      }
+      if (socket != invalidSocket)
+        disableNagle (socket);
+    }
+    if (socket == invalidSocket) {
+      cleanup ();
+      return invalidHandle;
+    }
+    disableSigPipe (socket);
+    return static_cast<Handle> (socket);
+  }
+
+  void close (Handle socket, const std::string& unixPath) {
+    if (socket == invalidHandle)
+      return;
+    closeSocket (native (socket));
+#ifndef _WIN32
+    if (!unixPath.empty ())
+      ::unlink (unixPath.c_str ());
+#else
+    (void)unixPath;
+#endif
+    cleanup ();
+  }
+
+  int pollReadable (Handle socket, int timeoutMs) {
+#ifdef _WIN32
+    WSAPOLLFD descriptor{ native (socket), POLLRDNORM, 0 };
+    return WSAPoll (&descriptor, 1, timeoutMs);
+#else
+    pollfd descriptor{ native (socket), POLLIN, 0 };
+    return ::poll (&descriptor, 1, timeoutMs);
+#endif
+  }
+
+  bool setNonBlocking (Handle socket) {
+#ifdef _WIN32
+    u_long on = 1;
+    return ioctlsocket (native (socket), FIONBIO, &on) == 0;
+#else
+    const int flags = ::fcntl (native (socket), F_GETFL, 0);
+    return flags >= 0 && ::fcntl (native (socket), F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+  }
+
+  Handle accept (Handle listener) {
+    const Socket client = ::accept (native (listener), nullptr, nullptr);
+    if (client == invalidSocket)
+      return invalidHandle;
+    // Accepted sockets pair with the listen () startup through their own close ()
+    startup ();
+    disableSigPipe (client);
+    disableNagle (client);
+    return static_cast<Handle> (client);
+  }
+
+  long send (Handle socket, const void* data, std::size_t size) {
+    const auto count = ::send (native (socket), static_cast<const char*> (data),
+                               static_cast<int> (size), sendFlags);
+    if (count >= 0)
+      return static_cast<long> (count);
+    return wouldBlock () ? 0 : -1;
+  }
+
+  long receive (Handle socket, void* data, std::size_t size) {
+    const auto count
+        = ::recv (native (socket), static_cast<char*> (data), static_cast<int> (size), 0);
+    if (count > 0)
+      return static_cast<long> (count);
+    if (count < 0 && wouldBlock ())
+      return 0;
+    return -1; // error, or the peer closed the connection
+  }
+
+} // namespace Net
@@ -0,0 +1,40 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Minimal stream socket layer (POSIX and Winsock) for the localhost servers
+
+#ifndef SOCKET_HPP
+#define SOCKET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Net {
+
+  // Native socket handle (int or SOCKET) widened so headers stay free of platform includes
+  using Handle = std::intptr_t;
+  constexpr Handle invalidHandle = -1;
+
+  // Endpoints are a localhost TCP port ("9464") or "unix:<path>" (POSIX only). Every
+  // successful listen () or connect () initialises Winsock and close () balances it.
+
+  // Bound and listening socket, or invalidHandle with the reason logged under owner. The
+  // socket file of a Unix endpoint is returned in unixPath and must be unlinked by close ().
+  Handle listen (const std::string& endpoint, const char* owner, std::string& unixPath,
+                 int backlog = 8);
+  Handle connect (const std::string& endpoint);
+  // Also unlinks unixPath when it is not empty
+  void close (Handle socket, const std::string& unixPath = {});
+
+  // > 0 when readable (or a connection is pending) within timeoutMs, 0 on timeout
+  int pollReadable (Handle socket, int timeoutMs);
+  bool setNonBlocking (Handle socket);
+  Handle accept (Handle listener);
+
+  // Bytes transferred, 0 when a non-blocking socket would block, -1 on error or hang up
+  long send (Handle socket, const void* data, std::size_t size);
+  long receive (Handle socket, void* data, std::size_t size);
+
+} // namespace Net
+
+#endif // SOCKET_HPP
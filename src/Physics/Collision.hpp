@@ -0,0 +1,179 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Swept (continuous) circle collision tests with exact time of impact
+
+#ifndef COLLISION_HPP
+#define COLLISION_HPP
+
+#include <GameEngine/FixedPoint.hpp>
+
+#include <raylib.h>
+
+#include <algorithm>
+#include <type_traits>
+
+namespace Physics {
+
+  // Works on raylib Vector2/Rectangle (float) and dotname::FixedVector2/FixedRectangle
+  template <typename Vector> using ScalarOf = std::remove_cv_t<decltype (Vector::x)>;
+  template <typename Vector>
+  using RectOf = typename dotname::ScalarTraits<ScalarOf<Vector>>::Rect;
+
+  // Time is the fraction of the swept motion (0 = start, 1 = end); normal points away from
+  // the surface that was hit, towards the circle.
+  template <typename Vector> struct BasicContact {
+    ScalarOf<Vector> time = ScalarOf<Vector> (1);
+    Vector normal{};
+  };
+  using Contact = BasicContact<Vector2>;
+
+  template <typename Vector> ScalarOf<Vector> dot (Vector a, Vector b) {
+    return a.x * b.x + a.y * b.y;
+  }
+
+  // Point moving along motion against a circle; earliest entry time in [0, maxTime]
+  template <typename Vector>
+  bool sweepPointCircle (Vector point, Vector motion, Vector center, ScalarOf<Vector> radius,
+                         ScalarOf<Vector> maxTime, ScalarOf<Vector>& time) {
+    using Scalar = ScalarOf<Vector>;
+    const Scalar zero (0);
+    const Vector m = { point.x - center.x, point.y - center.y };
+    const Scalar a = dot (motion, motion);
+    const Scalar b = dot (m, motion);
+    const Scalar c = dot (m, m) - radius * radius;
+    if (a <= zero || b >= zero)
+      return false; // not moving, or moving away from the center
+    const Scalar discriminant = b * b - a * c;
+    if (discriminant < zero)
+      return false;
+    const Scalar t = (-b - dotname::ScalarTraits<Scalar>::sqrt (discriminant)) / a;
+    if (t < zero || t > maxTime)
+      return false;
+    time = t;
+    return true;
+  }
+
+  // Moving circle against a static axis aligned rectangle. The swept shape is the
+  // rectangle grown by the radius with rounded corners: faces are tested with a slab
+  // test and corner regions against the corner circles. A circle that already overlaps
+  // the rectangle while moving into it reports a contact at time 0.
+  template <typename Vector>
+  bool sweepCircleRect (Vector center, Vector motion, ScalarOf<Vector> radius, RectOf<Vector> rect,
+                        ScalarOf<Vector> maxTime, BasicContact<Vector>& contact) {
+    using Scalar = ScalarOf<Vector>;
+    const Scalar zero (0), one (1);
+    const Scalar left = rect.x, right = rect.x + rect.width;
+    const Scalar top = rect.y, bottom = rect.y + rect.height;
+
+    // Initial overlap, resolved against the closest point of the rectangle
+    const Vector closest
+        = { std::clamp (center.x, left, right), std::clamp (center.y, top, bottom) };
+    const Vector offset = { center.x - closest.x, center.y - closest.y };
+    const Scalar distanceSq = dot (offset, offset);
+    if (distanceSq <= radius * radius) {
+      Vector normal;
+      if (distanceSq > zero) {
+        const Scalar distance = dotname::ScalarTraits<Scalar>::sqrt (distanceSq);
+        normal = Vector{ offset.x / distance, offset.y / distance };
+      } else {
+        // Center inside the rectangle: push out through the nearest face
+        const Scalar dl = center.x - left, dr = right - center.x;
+        const Scalar dt = center.y - top, db = bottom - center.y;
+        const Scalar m = std::min (std::min (dl, dr), std::min (dt, db));
+        normal = m == dl ? Vector{ -one, zero }
+                 : m == dr ? Vector{ one, zero }
+                 : m == dt ? Vector{ zero, -one }
+                           : Vector{ zero, one };
+      }
+      if (dot (motion, normal) >= zero)
+        return false; // separating already
+      contact = BasicContact<Vector>{ zero, normal };
+      return true;
+    }
+
+    // Slab test against the expanded rectangle
+    Scalar tEnter = zero, tExit = maxTime;
+    Vector normal = { zero, zero };
+    const Scalar lo[2] = { left - radius, top - radius };
+    const Scalar hi[2] = { right + radius, bottom + radius };
+    const Scalar p[2] = { center.x, center.y };
+    const Scalar d[2] = { motion.x, motion.y };
+    for (int axis = 0; axis < 2; axis++) {
+      if (d[axis] == zero) {
+        if (p[axis] < lo[axis] || p[axis] > hi[axis])
+          return false;
+        continue;
+      }
+      Scalar t0 = (lo[axis] - p[axis]) / d[axis];
+      Scalar t1 = (hi[axis] - p[axis]) / d[axis];
+      Scalar sign = -one;
+      if (t0 > t1) {
+        std::swap (t0, t1);
+        sign = one;
+      }
+      if (t0 > tEnter) {
+        tEnter = t0;
+        normal = axis == 0 ? Vector{ sign, zero } : Vector{ zero, sign };
+      }
+      tExit = std::min (tExit, t1);
+      if (tEnter > tExit)
+        return false;
+    }
+    // A start inside the expanded box without overlap lies in a corner region (tEnter = 0)
+    const Vector hit = { center.x + motion.x * tEnter, center.y + motion.y * tEnter };
+    const bool insideX = hit.x >= left && hit.x <= right;
+    const bool insideY = hit.y >= top && hit.y <= bottom;
+    if (insideX || insideY) {
+      contact = BasicContact<Vector>{ tEnter, normal };
+      return true;
+    }
+
+    // Corner region: only the circle around that corner can be hit
+    const Vector corner = { hit.x < left ? left : right, hit.y < top ? top : bottom };
+    Scalar t = zero;
+    if (!sweepPointCircle (center, motion, corner, radius, maxTime, t))
+      return false;
+    const Vector at
+        = { center.x + motion.x * t - corner.x, center.y + motion.y * t - corner.y };
+    const Scalar length = dotname::ScalarTraits<Scalar>::sqrt (dot (at, at));
+    contact = BasicContact<Vector>{
+      t, length > zero ? Vector{ at.x / length, at.y / length } : normal
+    };
+    return true;
+  }
+
+  // Moving circle kept inside bounds; earliest time it touches one of the four walls.
+  // The normal tells which wall: (1, 0) left, (-1, 0) right, (0, 1) top, (0, -1) bottom.
+  template <typename Vector>
+  bool sweepCircleBounds (Vector center, Vector motion, ScalarOf<Vector> radius,
+                          RectOf<Vector> bounds, ScalarOf<Vector> maxTime,
+                          BasicContact<Vector>& contact) {
+    using Scalar = ScalarOf<Vector>;
+    const Scalar zero (0), one (1);
+    bool found = false;
+    Scalar best = zero;
+    Vector normal = { zero, zero };
+    auto test = [&] (Scalar position, Scalar velocity, Scalar limit, Vector wallNormal) {
+      // velocity is signed towards the wall; already touching counts as time 0
+      if (velocity <= zero)
+        return;
+      const Scalar t = std::max (zero, (limit - position) / velocity);
+      if (t <= maxTime && (!found || t < best)) {
+        found = true;
+        best = t;
+        normal = wallNormal;
+      }
+    };
+    test (-center.x, -motion.x, -(bounds.x + radius), Vector{ one, zero });
+    test (center.x, motion.x, bounds.x + bounds.width - radius, Vector{ -one, zero });
+    test (-center.y, -motion.y, -(bounds.y + radius), Vector{ zero, one });
+    test (center.y, motion.y, bounds.y + bounds.height - radius, Vector{ zero, -one });
+    if (!found)
+      return false;
+    contact = BasicContact<Vector>{ best, normal };
+    return true;
+  }
+
+} // namespace Physics
+
+#endif // COLLISION_HPP
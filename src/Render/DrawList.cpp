@@ -0,0 +1,146 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Retained per frame draw list, sorted and submitted as batched quads
+
+#include "DrawList.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <rlgl.h>
+
+namespace Render {
+
+  namespace {
+    constexpr std::uint64_t shapeGroup = 0;
+    constexpr std::uint64_t textGroup = 1;
+
+    std::uint64_t groupOf (std::uint64_t key) {
+      return (key >> 40) & 0xff;
+    }
+  } // namespace
+
+  DrawList::DrawList (std::size_t reserve) {
+    commands_.reserve (reserve);
+    for (int i = 0; i <= circleSegments; i++) {
+      const float angle = 2.0f * PI * i / circleSegments;
+      unitCircle_[i] = Vector2{ std::cos (angle), std::sin (angle) };
+    }
+  }
+
+  void DrawList::push (Kind kind, int layer, const Command& command) {
+    const std::uint64_t group = kind == Kind::Text ? textGroup : shapeGroup;
+    Command entry = command;
+    entry.kind = kind;
+    entry.key = (static_cast<std::uint64_t> (layer + 0x8000) & 0xffff) << 48 | group << 40
+                | (commands_.size () & 0xffffffffffull); // order breaks ties, sort stays stable
+    commands_.push_back (entry);
+  }
+
+  void DrawList::rectangle (Rectangle rect, Color color, int layer) {
+    push (Kind::Rectangle, layer,
+          Command{ 0, Kind::Rectangle, color, rect.x, rect.y, rect.width, rect.height, nullptr });
+  }
+
+  void DrawList::circle (Vector2 center, float radius, Color color, int layer) {
+    push (Kind::Circle, layer,
+          Command{ 0, Kind::Circle, color, center.x, center.y, radius, radius, nullptr });
+  }
+
+  void DrawList::text (const char* text, int x, int y, int fontSize, Color color, int layer) {
+    push (Kind::Text, layer,
+          Command{ 0, Kind::Text, color, static_cast<float> (x), static_cast<float> (y),
+                   static_cast<float> (fontSize), 0.0f, text });
+  }
+
+  void DrawList::submit () {
+    stats_ = DrawStats{};
+    stats_.commands = commands_.size ();
+    std::sort (commands_.begin (), commands_.end (),
+               [] (const Command& l, const Command& r) { return l.key < r.key; });
+
+    std::size_t next = 0;
+    while (next < commands_.size ()) {
+      const std::uint64_t key = commands_[next].key;
+      next = groupOf (key) == textGroup ? submitText (next) : submitShapes (next);
+      stats_.batches++;
+      stats_.estimatedBatches++;
+    }
+    commands_.clear ();
+  }
+
+  // One RL_QUADS run on the shapes texture for every rectangle and circle up to the next
+  // layer or texture change, same vertex layout as raylib's DrawRectanglePro/DrawCircleSector
+  std::size_t DrawList::submitShapes (std::size_t first) {
+    const Texture2D texture = GetShapesTexture ();
+    const Rectangle source = GetShapesTextureRectangle ();
+    const float u0 = source.x / texture.width;
+    const float v0 = source.y / texture.height;
+    const float u1 = (source.x + source.width) / texture.width;
+    const float v1 = (source.y + source.height) / texture.height;
+    const std::uint64_t run = commands_[first].key >> 40;
+
+    rlSetTexture (texture.id);
+    rlBegin (RL_QUADS);
+    rlNormal3f (0.0f, 0.0f, 1.0f);
+
+    std::size_t i = first;
+    for (; i < commands_.size () && (commands_[i].key >> 40) == run; i++) {
+      const Command& command = commands_[i];
+      if (command.kind == Kind::Rectangle) {
+        if (rlCheckRenderBatchLimit (4))
+          stats_.estimatedBatches++;
+        rlColor4ub (command.color.r, command.color.g, command.color.b, command.color.a);
+        rlTexCoord2f (u0, v0);
+        rlVertex2f (command.x, command.y);
+        rlTexCoord2f (u0, v1);
+        rlVertex2f (command.x, command.y + command.height);
+        rlTexCoord2f (u1, v1);
+        rlVertex2f (command.x + command.width, command.y + command.height);
+        rlTexCoord2f (u1, v0);
+        rlVertex2f (command.x + command.width, command.y);
+        stats_.vertices += 4;
+        continue;
+      }
+
+      // Small circles use every 2nd or 4th point of the table; each quad covers two segments
+      const float radius = command.width;
+      const int stride = radius < 6.0f ? 4 : radius < 24.0f ? 2 : 1;
+      const int quads = circleSegments / stride / 2;
+      if (rlCheckRenderBatchLimit (4 * quads))
+        stats_.estimatedBatches++;
+      rlColor4ub (command.color.r, command.color.g, command.color.b, command.color.a);
+      for (int q = 0; q < quads; q++) {
+        const Vector2& a = unitCircle_[2 * q * stride];
+        const Vector2& b = unitCircle_[(2 * q + 1) * stride];
+        const Vector2& c = unitCircle_[(2 * q + 2) * stride];
+        rlTexCoord2f (u0, v0);
+        rlVertex2f (command.x, command.y);
+        rlTexCoord2f (u1, v1);
+        rlVertex2f (command.x + c.x * radius, command.y + c.y * radius);
+        rlTexCoord2f (u0, v1);
+        rlVertex2f (command.x + b.x * radius, command.y + b.y * radius);
+        rlTexCoord2f (u1, v0);
+        rlVertex2f (command.x + a.x * radius, command.y + a.y * radius);
+      }
+      stats_.vertices += 4 * quads;
+    }
+
+    rlEnd ();
+    rlSetTexture (0);
+    return i;
+  }
+
+  // Glyphs of every string in the run come from the font texture and batch together
+  std::size_t DrawList::submitText (std::size_t first) {
+    const std::uint64_t run = commands_[first].key >> 40;
+    std::size_t i = first;
+    for (; i < commands_.size () && (commands_[i].key >> 40) == run; i++) {
+      const Command& command = commands_[i];
+      DrawText (command.text, static_cast<int> (command.x), static_cast<int> (command.y),
+                static_cast<int> (command.width), command.color);
+    }
+    return i;
+  }
+
+} // namespace Render
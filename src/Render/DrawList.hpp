@@ -0,0 +1,73 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Retained per frame draw list, sorted and submitted as batched quads
+
+#ifndef DRAWLIST_HPP
+#define DRAWLIST_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <raylib.h>
+
+namespace Render {
+
+  struct DrawStats {
+    std::size_t commands = 0;
+    std::size_t batches = 0;  // runs of commands sharing texture and primitive mode
+    std::size_t vertices = 0; // vertices written by the shape batches
+    // Batches plus the flushes a full vertex buffer forces, as counted here. raylib also
+    // flushes on its own (state changes, EndDrawing), so this is not a count of GL draw calls.
+    std::size_t estimatedBatches = 0;
+  };
+
+  // Shapes are recorded during the frame and drawn by submit () in layer order. Rectangles and
+  // circles share raylib's shapes texture and quad mode, so every shape in a layer goes out
+  // in one batch instead of one immediate mode call per object.
+  class DrawList {
+  public:
+    explicit DrawList (std::size_t reserve = 1024);
+
+    void rectangle (Rectangle rect, Color color, int layer = 0);
+    void circle (Vector2 center, float radius, Color color, int layer = 0);
+    // text must stay valid until submit () (literals or FrameArena::format)
+    void text (const char* text, int x, int y, int fontSize, Color color, int layer = 0);
+
+    // Draws and clears the list; call between BeginDrawing () and EndDrawing ()
+    void submit ();
+
+    // Commands recorded since the last submit
+    std::size_t size () const {
+      return commands_.size ();
+    }
+    const DrawStats& stats () const {
+      return stats_;
+    }
+
+  private:
+    enum class Kind : std::uint8_t { Rectangle, Circle, Text };
+
+    struct Command {
+      std::uint64_t key; // layer, texture group, submission order
+      Kind kind;
+      Color color;
+      float x, y, width, height; // circles: centre and radius in width
+      const char* text;
+    };
+
+    static constexpr int circleSegments = 32;
+
+    void push (Kind kind, int layer, const Command& command);
+    std::size_t submitShapes (std::size_t first);
+    std::size_t submitText (std::size_t first);
+
+    std::vector<Command> commands_; // capacity kept between frames
+    std::array<Vector2, circleSegments + 1> unitCircle_;
+    DrawStats stats_;
+  };
+
+} // namespace Render
+
+#endif // DRAWLIST_HPP
@@ -0,0 +1,144 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Dynamic internal resolution: offscreen render target scaled to a frame time budget
+
+#include "ResolutionScaler.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Render {
+
+  namespace {
+    // Weight of the newest render time in the average
+    constexpr double renderSmoothing = 0.1;
+    // Average render time above budget * (1 + tolerance) counts as a missed frame
+    constexpr double budgetTolerance = 0.1;
+    // Render times this long are stalls (loading, debugger), not render cost
+    constexpr double stallSeconds = 0.25;
+    // Consecutive missed frames before the scale drops
+    constexpr int overBudgetFrames = 10;
+    // Frames at budget before probing a larger scale, doubled after a failed probe
+    constexpr int initialProbeDelay = 120;
+    constexpr int maxProbeDelay = 120 * 32;
+    // Frames a probe has to hold the budget to be kept
+    constexpr int probeWindow = 60;
+  } // namespace
+
+  ResolutionScaler::ResolutionScaler (int virtualWidth, int virtualHeight,
+                                      const ScalingConfig& config)
+      : virtualWidth_ (static_cast<float> (std::max (1, virtualWidth))),
+        virtualHeight_ (static_cast<float> (std::max (1, virtualHeight))), config_ (config),
+        area_{ 0, 0, static_cast<float> (GetScreenWidth ()),
+               static_cast<float> (GetScreenHeight ()) },
+        probeDelay_ (initialProbeDelay) {
+    config_.maxScale = std::max (config_.maxScale, 0.05f);
+    config_.minScale = std::clamp (config_.minScale, 0.05f, config_.maxScale);
+    config_.step = std::max (config_.step, 0.01f);
+    stats_.scale = stats_.lowestScale = config_.maxScale;
+    resize ();
+  }
+
+  ResolutionScaler::~ResolutionScaler () {
+    if (target_.id != 0)
+      UnloadRenderTexture (target_);
+  }
+
+  // Largest part of the area with the game's aspect ratio, centred
+  Rectangle ResolutionScaler::viewport () const {
+    const float width = std::max (area_.width, 1.0f);
+    const float height = std::max (area_.height, 1.0f);
+    const float pixelsPerUnit = std::min (width / virtualWidth_, height / virtualHeight_);
+    const float w = virtualWidth_ * pixelsPerUnit;
+    const float h = virtualHeight_ * pixelsPerUnit;
+    return Rectangle{ area_.x + (width - w) / 2, area_.y + (height - h) / 2, w, h };
+  }
+
+  void ResolutionScaler::resize () {
+    const Rectangle view = viewport ();
+    const int width = std::max (1, static_cast<int> (std::lround (view.width * stats_.scale)));
+    const int height = std::max (1, static_cast<int> (std::lround (view.height * stats_.scale)));
+    if (target_.id != 0 && width == stats_.width && height == stats_.height)
+      return;
+    if (target_.id != 0)
+      UnloadRenderTexture (target_);
+    target_ = LoadRenderTexture (width, height);
+    SetTextureFilter (target_.texture, TEXTURE_FILTER_BILINEAR);
+    stats_.width = width;
+    stats_.height = height;
+  }
+
+  void ResolutionScaler::begin (Color background) {
+    BeginTextureMode (target_);
+    ClearBackground (background);
+    Camera2D camera{};
+    camera.zoom = static_cast<float> (stats_.width) / virtualWidth_;
+    BeginMode2D (camera);
+  }
+
+  void ResolutionScaler::end () {
+    EndMode2D ();
+    EndTextureMode ();
+  }
+
+  void ResolutionScaler::present (Rectangle area) {
+    const bool resized = !sameSize (area);
+    area_ = area;
+    // Render textures are stored bottom up, the negative height flips them
+    const Rectangle source{ 0, 0, static_cast<float> (target_.texture.width),
+                            -static_cast<float> (target_.texture.height) };
+    DrawTexturePro (target_.texture, source, viewport (), Vector2{ 0, 0 }, 0.0f, WHITE);
+    if (resized)
+      resize ();
+  }
+
+  void ResolutionScaler::frameDone (double renderSeconds, double budgetSeconds) {
+    if (!config_.dynamic || budgetSeconds <= 0.0 || renderSeconds > stallSeconds)
+      return;
+    if (averageRender_ == 0.0)
+      averageRender_ = renderSeconds;
+    else
+      averageRender_ += (renderSeconds - averageRender_) * renderSmoothing;
+    const bool over = averageRender_ > budgetSeconds * (1.0 + budgetTolerance);
+
+    float scale = stats_.scale;
+    if (probeFrames_ > 0) {
+      if (over) {
+        probeFrames_ = 0;
+        probeDelay_ = std::min (probeDelay_ * 2, maxProbeDelay);
+        scale -= config_.step;
+      } else if (--probeFrames_ == 0) {
+        probeDelay_ = initialProbeDelay;
+      }
+    } else if (over) {
+      atBudget_ = 0;
+      if (++overBudget_ >= overBudgetFrames) {
+        overBudget_ = 0;
+        scale -= config_.step;
+      }
+    } else {
+      overBudget_ = 0;
+      if (stats_.scale < config_.maxScale && ++atBudget_ >= probeDelay_) {
+        atBudget_ = 0;
+        probeFrames_ = probeWindow;
+        scale += config_.step;
+      }
+    }
+
+    scale = std::clamp (scale, config_.minScale, config_.maxScale);
+    if (scale == stats_.scale)
+      return;
+    stats_.scale = scale;
+    stats_.lowestScale = std::min (stats_.lowestScale, scale);
+    stats_.changes++;
+    averageRender_ = 0.0; // judge the new scale on its own frames
+    resize ();
+  }
+
+  Vector2 ResolutionScaler::toGame (Vector2 windowPoint) const {
+    const Rectangle view = viewport ();
+    return Vector2{ (windowPoint.x - view.x) * virtualWidth_ / view.width,
+                    (windowPoint.y - view.y) * virtualHeight_ / view.height };
+  }
+
+} // namespace Render
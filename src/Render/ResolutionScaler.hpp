@@ -0,0 +1,87 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Dynamic internal resolution: offscreen render target scaled to a frame time budget
+
+#ifndef RESOLUTIONSCALER_HPP
+#define RESOLUTIONSCALER_HPP
+
+#include <cstdint>
+
+#include <raylib.h>
+
+namespace Render {
+
+  struct ScalingConfig {
+    // Share of the presented size the target may shrink to
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+    // Scale change per adjustment; the target is reallocated on every change
+    float step = 0.125f;
+    // false keeps maxScale regardless of frame time
+    bool dynamic = true;
+  };
+
+  struct ScalingStats {
+    float scale = 1.0f;
+    int width = 0; // render target size in pixels
+    int height = 0;
+    std::uint64_t changes = 0;
+    float lowestScale = 1.0f;
+  };
+
+  // The game draws in fixed game units (virtualWidth x virtualHeight) into a render target
+  // whose pixel size is the letterboxed presentation area times the current scale;
+  // present () then upscales it with bilinear filtering. Frames whose rendering misses the
+  // budget lower the scale; after a while at budget the scale is probed one step up, and a
+  // probe that misses doubles the wait before the next one. Requires a window (GL context)
+  // for its whole lifetime.
+  class ResolutionScaler {
+  public:
+    ResolutionScaler (int virtualWidth, int virtualHeight, const ScalingConfig& config = {});
+    ~ResolutionScaler ();
+    ResolutionScaler (const ResolutionScaler&) = delete;
+    ResolutionScaler& operator= (const ResolutionScaler&) = delete;
+
+    // Draws between begin () and end () go to the target in game units
+    void begin (Color background);
+    void end ();
+    // Letterboxes the upscaled target into area of the window (all of it for a single game);
+    // call before EndDrawing (). A new area size reallocates the target for the next frame.
+    void present (Rectangle area);
+
+    // renderSeconds: time spent drawing and presenting the frame, which is what the scale
+    // changes; budgetSeconds: frame time to hold. The frame interval would also count the
+    // simulation and pacing waits, and a CPU bound game would then shrink to minScale
+    // without rendering any faster.
+    void frameDone (double renderSeconds, double budgetSeconds);
+
+    // Window pixel to game units within the last presented area, for pointer input
+    Vector2 toGame (Vector2 windowPoint) const;
+
+    const ScalingStats& stats () const {
+      return stats_;
+    }
+
+  private:
+    void resize ();
+    Rectangle viewport () const;
+    bool sameSize (Rectangle area) const {
+      return area.width == area_.width && area.height == area_.height;
+    }
+
+    const float virtualWidth_;
+    const float virtualHeight_;
+    ScalingConfig config_;
+    ScalingStats stats_;
+    RenderTexture2D target_{};
+    Rectangle area_{};
+    double averageRender_ = 0.0;
+    int overBudget_ = 0;     // consecutive frames over budget
+    int atBudget_ = 0;       // consecutive frames within budget
+    int probeDelay_;         // frames at budget before trying a larger scale
+    int probeFrames_ = 0;    // > 0 while a probe is being judged
+  };
+
+} // namespace Render
+
+#endif // RESOLUTIONSCALER_HPP
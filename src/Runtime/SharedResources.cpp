@@ -0,0 +1,100 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Process wide window, audio device and note bank shared by every engine instance
+
+#include "SharedResources.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <raylib.h>
+
+namespace Runtime {
+
+  namespace {
+    std::mutex registryMutex;
+    std::weak_ptr<Platform> openPlatform;
+    std::vector<std::pair<BankKey, std::weak_ptr<ResourceBank>>> openBanks;
+
+    bool sameKey (const BankKey& a, const BankKey& b) {
+      return a.assetsPath == b.assetsPath && a.cacheDirectory == b.cacheDirectory
+             && a.storage == b.storage;
+    }
+
+    std::vector<std::string> noteFileNames () {
+      static const char* const noteNames[]
+          = { "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B" };
+      std::vector<std::string> fileNames;
+      for (int octave = 1; octave <= 4; octave++) {
+        for (const char* name : noteNames) {
+          fileNames.push_back (std::string (name) + std::to_string (octave) + ".wav");
+        }
+      }
+      return fileNames;
+    }
+  } // namespace
+
+  std::shared_ptr<Platform> Platform::acquire (int width, int height, const char* title) {
+    std::lock_guard<std::mutex> lock (registryMutex);
+    std::shared_ptr<Platform> platform = openPlatform.lock ();
+    if (!platform) {
+      platform.reset (new Platform (width, height, title));
+      openPlatform = platform;
+    }
+    return platform;
+  }
+
+  Platform::Platform (int width, int height, const char* title) {
+    // Initialization (Note windowTitle is unused on Android)
+    SetConfigFlags (FLAG_WINDOW_RESIZABLE);
+    InitWindow (width, height, title);
+
+    Vector2 mainMonitorPosition = GetMonitorPosition (0);
+    SetWindowPosition (mainMonitorPosition.x + (GetMonitorWidth (0) - GetScreenWidth ()) / 2,
+                       mainMonitorPosition.y + (GetMonitorHeight (0) - GetScreenHeight ()) / 2);
+
+    InitAudioDevice ();
+  }
+
+  Platform::~Platform () {
+    CloseAudioDevice ();
+    CloseWindow (); // Close window and OpenGL context
+  }
+
+  std::shared_ptr<ResourceBank> ResourceBank::acquire (const BankKey& key,
+                                                       std::shared_ptr<Platform> platform) {
+    std::lock_guard<std::mutex> lock (registryMutex);
+    for (auto it = openBanks.begin (); it != openBanks.end ();) {
+      std::shared_ptr<ResourceBank> bank = it->second.lock ();
+      if (!bank) {
+        it = openBanks.erase (it);
+        continue;
+      }
+      if (sameKey (it->first, key))
+        return bank;
+      ++it;
+    }
+    std::shared_ptr<ResourceBank> bank (new ResourceBank (key, std::move (platform)));
+    openBanks.emplace_back (key, bank);
+    return bank;
+  }
+
+  ResourceBank::ResourceBank (const BankKey& key, std::shared_ptr<Platform> platform)
+      : platform_ (std::move (platform)), cache_ (key.cacheDirectory), samples_ (key.storage) {
+    if (!index_.load (key.assetsPath)) {
+      LOG_D_STREAM << "No asset manifest, assets are resolved on disk" << std::endl;
+    }
+    samples_.load (key.assetsPath, noteFileNames (), &index_, &cache_);
+    LOG_I_FMT ("Audio bank: {} notes, {} bytes resident ({})", samples_.size (),
+               samples_.residentBytes (),
+               samples_.storage () == Audio::SampleBank::Storage::Adpcm ? "IMA-ADPCM" : "PCM");
+  }
+
+  ResourceBank::~ResourceBank () {
+    samples_.unload ();
+  }
+
+} // namespace Runtime
@@ -0,0 +1,68 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Process wide window, audio device and note bank shared by every engine instance
+
+#ifndef SHAREDRESOURCES_HPP
+#define SHAREDRESOURCES_HPP
+
+#include <Assets/AssetIndex.hpp>
+#include <Audio/SampleBank.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace Runtime {
+
+  // raylib has one window and one audio device per process. The first acquire () opens
+  // both, the last reference closes them; later callers join whatever window is open.
+  class Platform {
+  public:
+    static std::shared_ptr<Platform> acquire (int width, int height, const char* title);
+    ~Platform ();
+
+    Platform (const Platform&) = delete;
+    Platform& operator= (const Platform&) = delete;
+
+  private:
+    Platform (int width, int height, const char* title);
+  };
+
+  struct BankKey {
+    std::filesystem::path assetsPath;
+    std::filesystem::path cacheDirectory;
+    Audio::SampleBank::Storage storage = Audio::SampleBank::Storage::Pcm;
+  };
+
+  // Asset index, decoded asset cache and the 48 note samples, loaded once per distinct
+  // assets path and storage and shared by reference count. Sharing also keeps a single
+  // ADPCM mixer stream, which the sample bank supports only once per process.
+  class ResourceBank {
+  public:
+    static std::shared_ptr<ResourceBank> acquire (const BankKey& key,
+                                                  std::shared_ptr<Platform> platform);
+    ~ResourceBank ();
+
+    ResourceBank (const ResourceBank&) = delete;
+    ResourceBank& operator= (const ResourceBank&) = delete;
+
+    Audio::SampleBank& samples () {
+      return samples_;
+    }
+    const Audio::SampleBank& samples () const {
+      return samples_;
+    }
+
+  private:
+    ResourceBank (const BankKey& key, std::shared_ptr<Platform> platform);
+
+    // Released after the samples, which need the audio device
+    std::shared_ptr<Platform> platform_;
+    Assets::AssetIndex index_;
+    Assets::DecodedAssetCache cache_;
+    Audio::SampleBank samples_;
+  };
+
+} // namespace Runtime
+
+#endif // SHAREDRESOURCES_HPP
@@ -0,0 +1,150 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include <GameEngine/Simulation.hpp>
+#include <Physics/Collision.hpp>
+
+namespace dotname {
+
+  // Rules are read through rules () everywhere: with StaticRules every field is a compile
+  // time constant and the arithmetic below folds, with RuntimeRules they are loads.
+  template <typename Scalar, typename RulesSource>
+  BasicSimulation<Scalar, RulesSource>::BasicSimulation (const RulesSource& rules)
+      : rules_ (rules), courtWidth (rules_.get ().courtWidth),
+        courtHeight (rules_.get ().courtHeight) {
+    Reset ();
+  }
+
+  template <typename Scalar, typename RulesSource>
+  void BasicSimulation<Scalar, RulesSource>::Reset (void) {
+    using Vector = typename Traits::Vector;
+    const Rules& rules = rules_.get ();
+    const Scalar two (2);
+
+    // Initialize player
+    player.position = Vector{ Scalar (rules.paddleX), Scalar (rules.courtHeight / 2) };
+    player.size = Vector{ Scalar (rules.paddleWidth), Scalar (rules.paddleHeight) };
+    player.life = rules.maxLife;
+
+    // Initialize ball
+    ball.radius = rules.ballRadius;
+    ball.position = Vector{ player.position.x + Scalar (ball.radius),
+                            player.position.y - (player.size.y / two) - Scalar (ball.radius) };
+    ball.speed = Vector{ Scalar (0), Scalar (0) };
+    ball.active = false;
+
+    score = 0;
+    gameOver = false;
+    tick = 0;
+  }
+
+  template <typename Scalar, typename RulesSource>
+  const GameEvents& BasicSimulation<Scalar, RulesSource>::Step (const PaddleInput& input) {
+    using Vector = typename Traits::Vector;
+    const Rules& rules = rules_.get ();
+    const Scalar two (2), speed (rules.paddleSpeed);
+
+    events_.count = 0;
+    if (gameOver)
+      return events_;
+    tick++;
+
+    // Player movement logic
+    player.position.y -= speed * Traits::fromFloat (input.up);
+    if ((player.position.y - (player.size.y / two)) <= Scalar (0))
+      player.position.y = (player.size.y / two);
+
+    player.position.y += speed * Traits::fromFloat (input.down);
+    if ((player.position.y + player.size.y / two) >= Scalar (rules.courtHeight))
+      player.position.y = Scalar (rules.courtHeight) - (player.size.y / two);
+
+    // Ball launching logic
+    if (!ball.active && input.launch) {
+      ball.active = true;
+      ball.speed = Vector{ Scalar (rules.launchSpeed), Scalar (0) };
+    }
+
+    // Ball movement logic (collisions are resolved inside the swept step)
+    if (ball.active) {
+      StepBall ();
+    } else {
+      ball.position = Vector{ player.position.x + Scalar (ball.radius * 2), player.position.y };
+    }
+
+    // Game over logic
+    if (player.life <= 0) {
+      gameOver = true;
+      events_.push (GameEventType::GameOver, Traits::toVector2 (ball.position));
+    }
+    return events_;
+  }
+
+  // Move the ball by one tick of velocity. Walls and paddle are swept, so contacts are found
+  // at their exact time of impact and several bounces can happen within one step at any speed.
+  template <typename Scalar, typename RulesSource>
+  void BasicSimulation<Scalar, RulesSource>::StepBall (void) {
+    using Vector = typename Traits::Vector;
+    using Rect = typename Traits::Rect;
+    const Rules& rules = rules_.get ();
+    const Scalar zero (0), one (1), two (2);
+
+    const Rect court = { zero, zero, Scalar (rules.courtWidth), Scalar (rules.courtHeight) };
+    const Rect paddle = { player.position.x - (player.size.x / two),
+                          player.position.y - (player.size.y / two), player.size.x,
+                          player.size.y };
+    const Scalar radius (ball.radius);
+
+    Scalar remaining = one;
+    for (int bounce = 0; bounce < maxBouncesPerStep && remaining > zero; bounce++) {
+      const Vector motion = { ball.speed.x * remaining, ball.speed.y * remaining };
+
+      // Collision logic: ball vs walls and ball vs player, whichever comes first
+      Physics::BasicContact<Vector> wall, hit;
+      const bool hitWall
+          = Physics::sweepCircleBounds (ball.position, motion, radius, court, one, wall);
+      const bool hitPlayer
+          = ball.speed.x < zero
+            && Physics::sweepCircleRect (ball.position, motion, radius, paddle, one, hit);
+      if (!hitWall && !hitPlayer) {
+        ball.position.x += motion.x;
+        ball.position.y += motion.y;
+        return;
+      }
+
+      const bool playerFirst = hitPlayer && (!hitWall || hit.time <= wall.time);
+      const Scalar time = playerFirst ? hit.time : wall.time;
+      ball.position.x += motion.x * time;
+      ball.position.y += motion.y * time;
+      remaining *= one - time;
+
+      if (playerFirst) {
+        ball.speed.x *= -one;
+        ball.speed.y
+            = (ball.position.y - player.position.y) / (player.size.y / two)
+              * Scalar (rules.deflection);
+        score++;
+        events_.push (GameEventType::PaddleHit, Traits::toVector2 (ball.position));
+      } else if (wall.normal.x > zero) {
+        // Left wall: the ball is lost
+        ball.speed = Vector{ zero, zero };
+        ball.active = false;
+        player.life--;
+        events_.push (GameEventType::BallLost, Traits::toVector2 (ball.position));
+        return;
+      } else if (wall.normal.x < zero) {
+        ball.speed.x *= -one;
+        events_.push (GameEventType::WallBounce, Traits::toVector2 (ball.position));
+      } else {
+        ball.speed.y *= -one;
+        events_.push (GameEventType::WallBounce, Traits::toVector2 (ball.position));
+      }
+    }
+  }
+
+  template class BasicSimulation<float>;
+  template class BasicSimulation<Fixed>;
+  template class BasicSimulation<float, StaticRules<ClassicRuleSet>>;
+  template class BasicSimulation<Fixed, StaticRules<ClassicRuleSet>>;
+  template class BasicSimulation<float, StaticRules<ArcadeRuleSet>>;
+
+} // namespace dotname
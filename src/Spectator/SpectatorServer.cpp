@@ -0,0 +1,267 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Live game state stream for spectators, fanned out from one shared ring buffer
+
+#include "SpectatorServer.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace Spectator {
+
+  namespace {
+    // Upper bound on the time to notice new spectators while the game is paused
+    constexpr auto idleWake = std::chrono::milliseconds (20);
+    // Hundreds of spectators may connect at once, e.g. when a match is announced
+    constexpr int listenBacklog = 256;
+
+    std::size_t roundUpToPowerOfTwo (std::size_t value) {
+      std::size_t size = maxFrameBytes;
+      while (size < value)
+        size <<= 1;
+      return size;
+    }
+  } // namespace
+
+  SpectatorServer::SpectatorServer (std::size_t ringBytes, int keyframeInterval)
+      : ring_ (roundUpToPowerOfTwo (ringBytes)),
+        keyframeInterval_ (std::max (1, keyframeInterval)) {
+  }
+
+  SpectatorServer::~SpectatorServer () {
+    stop ();
+  }
+
+  bool SpectatorServer::start (const std::string& endpoint) {
+    stop ();
+    listener_ = Net::listen (endpoint, "Spectator", unixPath_, listenBacklog);
+    if (listener_ == Net::invalidHandle)
+      return false;
+    Net::setNonBlocking (listener_);
+    running_ = true;
+    thread_ = std::thread (&SpectatorServer::serve, this);
+    LOG_I_STREAM << "Spectator server listening on " << endpoint << std::endl;
+    return true;
+  }
+
+  void SpectatorServer::stop () {
+    if (!running_.exchange (false))
+      return;
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      published_.notify_one ();
+    }
+    thread_.join ();
+    for (const Client& client : clients_)
+      Net::close (client.socket);
+    clients_.clear ();
+    clientCount_ = 0;
+    Net::close (listener_, unixPath_);
+    listener_ = Net::invalidHandle;
+    unixPath_.clear ();
+  }
+
+  void SpectatorServer::publish (const TickState& state) {
+    bool due = ++sinceKeyframe_ >= keyframeInterval_;
+    if (keyframeRequested_.load (std::memory_order_relaxed))
+      due = keyframeRequested_.exchange (false) || due;
+    bool keyframe = false;
+    const std::size_t size = encoder_.encode (state, due, frame_, keyframe);
+    if (size == 0)
+      return;
+    if (keyframe)
+      sinceKeyframe_ = 0;
+
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      const std::size_t at = static_cast<std::size_t> (head_) & (ring_.size () - 1);
+      const std::size_t first = std::min (size, ring_.size () - at);
+      std::memcpy (ring_.data () + at, frame_, first);
+      std::memcpy (ring_.data (), frame_ + first, size - first);
+      if (keyframe)
+        lastKeyframe_ = head_;
+      head_ += size;
+    }
+    published_.notify_one ();
+
+    frames_.fetch_add (1, std::memory_order_relaxed);
+    bytesPublished_.fetch_add (size, std::memory_order_relaxed);
+    if (keyframe)
+      keyframes_.fetch_add (1, std::memory_order_relaxed);
+  }
+
+  SpectatorStats SpectatorServer::stats () const {
+    SpectatorStats stats;
+    stats.frames = frames_.load (std::memory_order_relaxed);
+    stats.keyframes = keyframes_.load (std::memory_order_relaxed);
+    stats.bytesPublished = bytesPublished_.load (std::memory_order_relaxed);
+    stats.bytesSent = bytesSent_.load (std::memory_order_relaxed);
+    stats.clients = clientCount_.load (std::memory_order_relaxed);
+    stats.accepted = accepted_.load (std::memory_order_relaxed);
+    stats.resyncs = resyncs_.load (std::memory_order_relaxed);
+    stats.dropped = dropped_.load (std::memory_order_relaxed);
+    return stats;
+  }
+
+  void SpectatorServer::serve () {
+    std::uint64_t seen = 0;
+    while (running_) {
+      acceptClients ();
+
+      std::unique_lock<std::mutex> lock (mutex_);
+      published_.wait_for (lock, idleWake, [&] { return !running_ || head_ != seen; });
+      const std::uint64_t head = head_;
+      seen = head;
+      const std::uint64_t begin = placeClients (head, lastKeyframe_);
+      // The only copy of the stream: everyone is served from this span after the unlock
+      pending_.resize (static_cast<std::size_t> (head - begin));
+      if (!pending_.empty ()) {
+        const std::size_t at = static_cast<std::size_t> (begin) & (ring_.size () - 1);
+        const std::size_t first = std::min (pending_.size (), ring_.size () - at);
+        std::memcpy (pending_.data (), ring_.data () + at, first);
+        std::memcpy (pending_.data () + first, ring_.data (), pending_.size () - first);
+      }
+      lock.unlock ();
+
+      sendToClients (begin, head);
+      clientCount_.store (clients_.size (), std::memory_order_relaxed);
+    }
+  }
+
+  void SpectatorServer::acceptClients () {
+    while (Net::pollReadable (listener_, 0) > 0) {
+      const Net::Handle socket = Net::accept (listener_);
+      if (socket == Net::invalidHandle)
+        break;
+      if (!Net::setNonBlocking (socket)) {
+        Net::close (socket);
+        continue;
+      }
+      clients_.push_back (Client{ socket, 0, true, true });
+      accepted_.fetch_add (1, std::memory_order_relaxed);
+    }
+  }
+
+  std::uint64_t SpectatorServer::placeClients (std::uint64_t head, std::uint64_t keyframe) {
+    const std::uint64_t ringSize = ring_.size ();
+    const std::uint64_t oldest = head > ringSize ? head - ringSize : 0;
+    const bool keyframeKept = keyframe != noKeyframe && keyframe >= oldest;
+    std::uint64_t begin = head;
+    for (std::size_t i = 0; i < clients_.size ();) {
+      Client& client = clients_[i];
+      if (client.waiting) {
+        if (!keyframeKept) {
+          keyframeRequested_ = true;
+          i++;
+          continue;
+        }
+        client.cursor = keyframe;
+        client.waiting = false;
+      } else if (head - client.cursor > ringSize / 2) {
+        if (client.aligned && keyframeKept && keyframe > client.cursor) {
+          client.cursor = keyframe;
+          resyncs_.fetch_add (1, std::memory_order_relaxed);
+        } else if (client.cursor < oldest) {
+          // Lapped in the middle of a frame: the rest of it is gone
+          Net::close (client.socket);
+          client = clients_.back ();
+          clients_.pop_back ();
+          dropped_.fetch_add (1, std::memory_order_relaxed);
+          continue;
+        }
+      }
+      begin = std::min (begin, client.cursor);
+      i++;
+    }
+    return begin;
+  }
+
+  void SpectatorServer::sendToClients (std::uint64_t begin, std::uint64_t head) {
+    for (std::size_t i = 0; i < clients_.size ();) {
+      Client& client = clients_[i];
+      if (client.waiting || client.cursor >= head) {
+        i++;
+        continue;
+      }
+      const long sent = Net::send (client.socket, pending_.data () + (client.cursor - begin),
+                                   static_cast<std::size_t> (head - client.cursor));
+      if (sent < 0) {
+        Net::close (client.socket);
+        client = clients_.back ();
+        clients_.pop_back ();
+        dropped_.fetch_add (1, std::memory_order_relaxed);
+        continue;
+      }
+      if (sent > 0) {
+        client.cursor += static_cast<std::uint64_t> (sent);
+        client.aligned = client.cursor == head;
+        bytesSent_.fetch_add (static_cast<std::uint64_t> (sent), std::memory_order_relaxed);
+      }
+      i++;
+    }
+  }
+
+  SpectatorClient::SpectatorClient () : buffer_ (1 << 16) {
+  }
+
+  SpectatorClient::~SpectatorClient () {
+    close ();
+  }
+
+  bool SpectatorClient::connect (const std::string& endpoint) {
+    close ();
+    socket_ = Net::connect (endpoint);
+    begin_ = end_ = 0;
+    decoder_.reset ();
+    return connected ();
+  }
+
+  void SpectatorClient::close () {
+    Net::close (socket_);
+    socket_ = Net::invalidHandle;
+  }
+
+  bool SpectatorClient::next (TickState& state, bool& keyframe, int timeoutMs) {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point deadline = Clock::now () + std::chrono::milliseconds (timeoutMs);
+    while (connected ()) {
+      const std::size_t available = end_ - begin_;
+      if (available >= frameHeaderBytes) {
+        const std::size_t payload = framePayloadSize (buffer_.data () + begin_);
+        if (available >= frameHeaderBytes + payload) {
+          const bool valid = decoder_.decode (buffer_.data () + begin_ + frameHeaderBytes,
+                                              payload, state, keyframe);
+          begin_ += frameHeaderBytes + payload;
+          if (valid)
+            return true;
+          LOG_W_STREAM << "Spectator: undecodable frame, disconnecting" << std::endl;
+          close ();
+          return false;
+        }
+      }
+      if (begin_ > 0) {
+        std::memmove (buffer_.data (), buffer_.data () + begin_, available);
+        begin_ = 0;
+        end_ = available;
+      }
+
+      const auto remaining
+          = std::chrono::duration_cast<std::chrono::milliseconds> (deadline - Clock::now ());
+      if (remaining.count () < 0
+          || Net::pollReadable (socket_, static_cast<int> (remaining.count ())) <= 0)
+        return false;
+      const long count = Net::receive (socket_, buffer_.data () + end_, buffer_.size () - end_);
+      if (count < 0) {
+        close ();
+        return false;
+      }
+      end_ += static_cast<std::size_t> (count);
+      bytesReceived_ += static_cast<std::uint64_t> (count);
+    }
+    return false;
+  }
+
+} // namespace Spectator
@@ -0,0 +1,140 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Live game state stream for spectators, fanned out from one shared ring buffer
+
+#ifndef SPECTATORSERVER_HPP
+#define SPECTATORSERVER_HPP
+
+#include "StateCodec.hpp"
+
+#include <Net/Socket.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Spectator {
+
+  struct SpectatorStats {
+    std::uint64_t frames = 0;
+    std::uint64_t keyframes = 0;
+    std::uint64_t bytesPublished = 0; // encoded once, whatever the number of spectators
+    std::uint64_t bytesSent = 0;      // over all spectators
+    std::uint64_t clients = 0;        // connected now
+    std::uint64_t accepted = 0;
+    std::uint64_t resyncs = 0; // slow spectators moved ahead to the latest keyframe
+    std::uint64_t dropped = 0; // spectators lapped in the middle of a frame, or hung up
+  };
+
+  // Streams the frames published by the game thread to every connected spectator, on
+  // 127.0.0.1:<port> or "unix:<path>" (POSIX only). Each tick is encoded once into a ring of
+  // frames; the sender thread copies the unsent span out once per wake up and writes it to
+  // every non-blocking socket from there, so the per spectator cost is a send. A spectator
+  // starts at the latest keyframe, and one falling half a ring behind skips to it.
+  class SpectatorServer {
+  public:
+    // ringBytes is rounded up to a power of two
+    explicit SpectatorServer (std::size_t ringBytes = 1 << 20, int keyframeInterval = 120);
+    ~SpectatorServer ();
+
+    SpectatorServer (const SpectatorServer&) = delete;
+    SpectatorServer& operator= (const SpectatorServer&) = delete;
+
+    // False (with a logged reason) when the endpoint is invalid or cannot be bound
+    bool start (const std::string& endpoint);
+    void stop ();
+
+    // Game thread only: encodes state (a keyframe when due) and wakes the sender
+    void publish (const TickState& state);
+
+    SpectatorStats stats () const;
+
+  private:
+    struct Client {
+      Net::Handle socket;
+      std::uint64_t cursor; // absolute ring offset of the next byte to send
+      bool aligned;         // cursor is on a frame boundary
+      bool waiting;         // no keyframe to start from yet
+    };
+
+    void serve ();
+    void acceptClients ();
+    // Moves the cursors of new and slow clients; returns the oldest byte still to be sent
+    std::uint64_t placeClients (std::uint64_t head, std::uint64_t keyframe);
+    void sendToClients (std::uint64_t begin, std::uint64_t head);
+
+    static constexpr std::uint64_t noKeyframe = ~std::uint64_t{ 0 };
+
+    // Shared with the game thread under mutex_
+    std::vector<std::uint8_t> ring_;
+    std::uint64_t head_ = 0;
+    std::uint64_t lastKeyframe_ = noKeyframe;
+    std::mutex mutex_;
+    std::condition_variable published_;
+
+    // Game thread
+    StateEncoder encoder_;
+    std::uint8_t frame_[maxFrameBytes];
+    int keyframeInterval_;
+    int sinceKeyframe_ = 0;
+    std::atomic<bool> keyframeRequested_{ false };
+
+    // Sender thread
+    std::vector<Client> clients_;
+    std::vector<std::uint8_t> pending_; // unsent span copied out of the ring
+    Net::Handle listener_ = Net::invalidHandle;
+    std::string unixPath_;
+    std::atomic<bool> running_{ false };
+    std::thread thread_;
+
+    std::atomic<std::uint64_t> frames_{ 0 };
+    std::atomic<std::uint64_t> keyframes_{ 0 };
+    std::atomic<std::uint64_t> bytesPublished_{ 0 };
+    std::atomic<std::uint64_t> bytesSent_{ 0 };
+    std::atomic<std::uint64_t> clientCount_{ 0 };
+    std::atomic<std::uint64_t> accepted_{ 0 };
+    std::atomic<std::uint64_t> resyncs_{ 0 };
+    std::atomic<std::uint64_t> dropped_{ 0 };
+  };
+
+  // Connects to a SpectatorServer and decodes its frames, for tools and tests
+  class SpectatorClient {
+  public:
+    SpectatorClient ();
+    ~SpectatorClient ();
+
+    SpectatorClient (const SpectatorClient&) = delete;
+    SpectatorClient& operator= (const SpectatorClient&) = delete;
+
+    bool connect (const std::string& endpoint);
+    void close ();
+    bool connected () const {
+      return socket_ != Net::invalidHandle;
+    }
+
+    // Next frame, waiting up to timeoutMs. False on timeout, or with the connection closed
+    // when the server hung up or the stream could not be decoded.
+    bool next (TickState& state, bool& keyframe, int timeoutMs);
+
+    // Including the size headers
+    std::uint64_t bytesReceived () const {
+      return bytesReceived_;
+    }
+
+  private:
+    Net::Handle socket_ = Net::invalidHandle;
+    std::vector<std::uint8_t> buffer_;
+    std::size_t begin_ = 0;
+    std::size_t end_ = 0;
+    StateDecoder decoder_;
+    std::uint64_t bytesReceived_ = 0;
+  };
+
+} // namespace Spectator
+
+#endif // SPECTATORSERVER_HPP
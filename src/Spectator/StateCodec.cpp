@@ -0,0 +1,262 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Per tick game state as bit packed keyframes and predicted deltas for spectators
+
+#include "StateCodec.hpp"
+
+#include <algorithm>
+
+namespace Spectator {
+
+  namespace {
+    static_assert (static_cast<int> (dotname::GameEventType::GameOver) == 3,
+                   "event types are coded in two bits");
+    constexpr int eventTypeBits = 2;
+
+    // MSB first into a fixed buffer; running out of room sets overflow instead of writing
+    class BitWriter {
+    public:
+      BitWriter (std::uint8_t* data, std::size_t capacity) : data_ (data), capacity_ (capacity) {
+      }
+
+      void bits (std::uint64_t value, int count) {
+        while (count > 0) {
+          const int take = std::min (count, 8 - used_);
+          const unsigned chunk
+              = static_cast<unsigned> (value >> (count - take)) & ((1u << take) - 1);
+          current_ = static_cast<unsigned> (current_ << take) | chunk;
+          used_ += take;
+          count -= take;
+          if (used_ == 8)
+            flushByte ();
+        }
+      }
+
+      // Exp-Golomb, for values below 2^63
+      void unsignedCode (std::uint64_t value) {
+        const std::uint64_t coded = value + 1;
+        int length = 0;
+        while (length < 64 && (coded >> length) > 1)
+          length++;
+        bits (0, length);
+        bits (coded, length + 1);
+      }
+
+      // Zigzag maps 0, -1, 1, -2, ... to 0, 1, 2, 3, ... so small residuals stay short
+      void signedCode (std::int64_t value) {
+        unsignedCode (value < 0 ? (static_cast<std::uint64_t> (-(value + 1)) << 1) | 1
+                                : static_cast<std::uint64_t> (value) << 1);
+      }
+
+      // Bytes written with the last byte zero padded, 0 on overflow
+      std::size_t finish () {
+        if (used_ > 0) {
+          current_ <<= 8 - used_;
+          flushByte ();
+        }
+        return overflow_ ? 0 : size_;
+      }
+
+    private:
+      void flushByte () {
+        if (size_ < capacity_)
+          data_[size_++] = static_cast<std::uint8_t> (current_);
+        else
+          overflow_ = true;
+        current_ = 0;
+        used_ = 0;
+      }
+
+      std::uint8_t* data_;
+      std::size_t capacity_;
+      std::size_t size_ = 0;
+      unsigned current_ = 0;
+      int used_ = 0;
+      bool overflow_ = false;
+    };
+
+    // Reading past the end yields zeros and sets failed
+    class BitReader {
+    public:
+      BitReader (const std::uint8_t* data, std::size_t size) : data_ (data), size_ (size) {
+      }
+
+      std::uint64_t bits (int count) {
+        std::uint64_t value = 0;
+        while (count > 0) {
+          if (position_ >= size_ * 8) {
+            failed_ = true;
+            return 0;
+          }
+          const int offset = static_cast<int> (position_ & 7);
+          const int take = std::min (count, 8 - offset);
+          const unsigned byte = data_[position_ >> 3];
+          const unsigned chunk = (byte >> (8 - offset - take)) & ((1u << take) - 1);
+          value = (value << take) | chunk;
+          position_ += static_cast<std::size_t> (take);
+          count -= take;
+        }
+        return value;
+      }
+
+      std::uint64_t unsignedCode () {
+        int length = 0;
+        while (bits (1) == 0) {
+          if (failed_ || ++length > 63) {
+            failed_ = true;
+            return 0;
+          }
+        }
+        const std::uint64_t coded = (std::uint64_t{ 1 } << length) | bits (length);
+        return coded - 1;
+      }
+
+      std::int64_t signedCode () {
+        const std::uint64_t value = unsignedCode ();
+        return value & 1 ? -static_cast<std::int64_t> (value >> 1) - 1
+                         : static_cast<std::int64_t> (value >> 1);
+      }
+
+      bool failed () const {
+        return failed_;
+      }
+
+    private:
+      const std::uint8_t* data_;
+      std::size_t size_;
+      std::size_t position_ = 0;
+      bool failed_ = false;
+    };
+
+    // Fields after tick and time, as residuals against reference; a delta predicts the ball
+    // moving by its speed, a keyframe codes against zero
+    void writeFields (BitWriter& writer, const TickState& state, const TickState& reference,
+                      bool predictBall) {
+      const std::int64_t predictedX
+          = std::int64_t{ reference.ballX } + (predictBall ? reference.ballSpeedX : 0);
+      const std::int64_t predictedY
+          = std::int64_t{ reference.ballY } + (predictBall ? reference.ballSpeedY : 0);
+      writer.bits (state.ballActive, 1);
+      writer.bits (state.gameOver, 1);
+      writer.signedCode (state.ballX - predictedX);
+      writer.signedCode (state.ballY - predictedY);
+      writer.signedCode (std::int64_t{ state.ballSpeedX } - reference.ballSpeedX);
+      writer.signedCode (std::int64_t{ state.ballSpeedY } - reference.ballSpeedY);
+      writer.signedCode (std::int64_t{ state.paddleY } - reference.paddleY);
+      writer.signedCode (std::int64_t{ state.score } - reference.score);
+      writer.signedCode (std::int64_t{ state.life } - reference.life);
+      // Contacts happen at the ball, so their positions are short offsets from it
+      writer.unsignedCode (static_cast<std::uint64_t> (state.eventCount));
+      for (int i = 0; i < state.eventCount; i++) {
+        const TickEvent& event = state.events[i];
+        writer.bits (static_cast<std::uint64_t> (event.type), eventTypeBits);
+        writer.signedCode (std::int64_t{ event.x } - state.ballX);
+        writer.signedCode (std::int64_t{ event.y } - state.ballY);
+      }
+    }
+
+    std::int32_t narrow (std::int64_t value, bool& valid) {
+      if (value < INT32_MIN || value > INT32_MAX)
+        valid = false;
+      return static_cast<std::int32_t> (value);
+    }
+
+    bool readFields (BitReader& reader, TickState& state, const TickState& reference,
+                     bool predictBall) {
+      bool valid = true;
+      state.ballActive = reader.bits (1) != 0;
+      state.gameOver = reader.bits (1) != 0;
+      state.ballX = narrow (std::int64_t{ reference.ballX }
+                                + (predictBall ? reference.ballSpeedX : 0) + reader.signedCode (),
+                            valid);
+      state.ballY = narrow (std::int64_t{ reference.ballY }
+                                + (predictBall ? reference.ballSpeedY : 0) + reader.signedCode (),
+                            valid);
+      state.ballSpeedX = narrow (reference.ballSpeedX + reader.signedCode (), valid);
+      state.ballSpeedY = narrow (reference.ballSpeedY + reader.signedCode (), valid);
+      state.paddleY = narrow (reference.paddleY + reader.signedCode (), valid);
+      state.score = narrow (reference.score + reader.signedCode (), valid);
+      state.life = narrow (reference.life + reader.signedCode (), valid);
+      const std::uint64_t count = reader.unsignedCode ();
+      if (count > state.events.size ())
+        return false;
+      state.eventCount = static_cast<int> (count);
+      for (int i = 0; i < state.eventCount; i++) {
+        TickEvent& event = state.events[i];
+        event.type = static_cast<dotname::GameEventType> (reader.bits (eventTypeBits));
+        event.x = narrow (state.ballX + reader.signedCode (), valid);
+        event.y = narrow (state.ballY + reader.signedCode (), valid);
+      }
+      for (std::size_t i = state.eventCount; i < state.events.size (); i++)
+        state.events[i] = TickEvent{};
+      return valid && !reader.failed ();
+    }
+  } // namespace
+
+  bool operator== (const TickState& a, const TickState& b) {
+    if (a.tick != b.tick || a.timeUs != b.timeUs || a.ballX != b.ballX || a.ballY != b.ballY
+        || a.ballSpeedX != b.ballSpeedX || a.ballSpeedY != b.ballSpeedY || a.paddleY != b.paddleY
+        || a.score != b.score || a.life != b.life || a.ballActive != b.ballActive
+        || a.gameOver != b.gameOver || a.eventCount != b.eventCount)
+      return false;
+    for (int i = 0; i < a.eventCount; i++) {
+      if (a.events[i].type != b.events[i].type || a.events[i].x != b.events[i].x
+          || a.events[i].y != b.events[i].y)
+        return false;
+    }
+    return true;
+  }
+
+  std::size_t StateEncoder::encode (const TickState& state, bool keyframe, std::uint8_t* out,
+                                    bool& keyframeWritten) {
+    // A reset game or a clock step backwards cannot be coded as forward steps
+    keyframeWritten = keyframe || !hasPrevious_ || state.tick <= previous_.tick
+                      || state.timeUs < previous_.timeUs;
+    BitWriter writer (out + frameHeaderBytes, maxFrameBytes - frameHeaderBytes);
+    writer.bits (keyframeWritten, 1);
+    if (keyframeWritten) {
+      writer.bits (state.tick, 64);
+      writer.bits (state.timeUs, 64);
+      writeFields (writer, state, TickState{}, false);
+    } else {
+      const bool nextTick = state.tick == previous_.tick + 1;
+      writer.bits (nextTick, 1);
+      if (!nextTick)
+        writer.unsignedCode (state.tick - previous_.tick);
+      writer.unsignedCode (state.timeUs - previous_.timeUs);
+      writeFields (writer, state, previous_, true);
+    }
+    const std::size_t payload = writer.finish ();
+    if (payload == 0) {
+      hasPrevious_ = false;
+      return 0;
+    }
+    out[0] = static_cast<std::uint8_t> (payload & 0xff);
+    out[1] = static_cast<std::uint8_t> (payload >> 8);
+    previous_ = state;
+    hasPrevious_ = true;
+    return frameHeaderBytes + payload;
+  }
+
+  bool StateDecoder::decode (const std::uint8_t* payload, std::size_t size, TickState& state,
+                             bool& keyframe) {
+    BitReader reader (payload, size);
+    keyframe = reader.bits (1) != 0;
+    bool valid = false;
+    if (keyframe) {
+      state.tick = reader.bits (64);
+      state.timeUs = reader.bits (64);
+      valid = readFields (reader, state, TickState{}, false);
+    } else if (hasPrevious_) {
+      const bool nextTick = reader.bits (1) != 0;
+      state.tick = previous_.tick + (nextTick ? 1 : reader.unsignedCode ());
+      state.timeUs = previous_.timeUs + reader.unsignedCode ();
+      valid = readFields (reader, state, previous_, true);
+    }
+    hasPrevious_ = valid;
+    if (valid)
+      previous_ = state;
+    return valid;
+  }
+
+} // namespace Spectator
@@ -0,0 +1,123 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Per tick game state as bit packed keyframes and predicted deltas for spectators
+
+#ifndef STATECODEC_HPP
+#define STATECODEC_HPP
+
+#include <GameEngine/Simulation.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace Spectator {
+
+  // Positions and speeds are in 1/16 px, so float and Fixed simulations encode the same way
+  constexpr int subpixels = 16;
+
+  struct TickEvent {
+    dotname::GameEventType type;
+    std::int32_t x;
+    std::int32_t y;
+  };
+
+  struct TickState {
+    std::uint64_t tick = 0;
+    std::uint64_t timeUs = 0; // steady clock at publish, for latency on the same host
+    std::int32_t ballX = 0;
+    std::int32_t ballY = 0;
+    std::int32_t ballSpeedX = 0;
+    std::int32_t ballSpeedY = 0;
+    std::int32_t paddleY = 0;
+    std::int32_t score = 0;
+    std::int32_t life = 0;
+    bool ballActive = false;
+    bool gameOver = false;
+    std::array<TickEvent, dotname::GameEvents::capacity> events{};
+    int eventCount = 0;
+  };
+
+  bool operator== (const TickState& a, const TickState& b);
+  inline bool operator!= (const TickState& a, const TickState& b) {
+    return !(a == b);
+  }
+
+  inline std::int32_t toSubpixels (float value) {
+    return static_cast<std::int32_t> (std::lround (value * subpixels));
+  }
+
+  // State after a step, with the events it produced
+  template <typename Simulation>
+  TickState capture (const Simulation& simulation, const dotname::GameEvents& events,
+                     std::uint64_t timeUs) {
+    using Traits = typename Simulation::Traits;
+    const Vector2 ball = Traits::toVector2 (simulation.ball.position);
+    const Vector2 speed = Traits::toVector2 (simulation.ball.speed);
+    TickState state;
+    state.tick = simulation.tick;
+    state.timeUs = timeUs;
+    state.ballX = toSubpixels (ball.x);
+    state.ballY = toSubpixels (ball.y);
+    state.ballSpeedX = toSubpixels (speed.x);
+    state.ballSpeedY = toSubpixels (speed.y);
+    state.paddleY = toSubpixels (Traits::toVector2 (simulation.player.position).y);
+    state.score = simulation.score;
+    state.life = simulation.player.life;
+    state.ballActive = simulation.ball.active;
+    state.gameOver = simulation.gameOver;
+    for (const dotname::GameEvent& event : events)
+      state.events[state.eventCount++]
+          = TickEvent{ event.type, toSubpixels (event.position.x), toSubpixels (event.position.y) };
+    return state;
+  }
+
+  // Frame on the wire: payload size as u16 little endian, then the payload bits MSB first.
+  // The first bit marks a keyframe (every field, decodable on its own) or a delta against
+  // the previous frame. Deltas code residuals against a prediction as signed Exp-Golomb:
+  // the ball moves by its speed, everything else stays and the tick advances by one, so a
+  // tick without contacts costs a bit per field plus the timestamp step.
+  constexpr std::size_t frameHeaderBytes = 2;
+  constexpr std::size_t maxFrameBytes = 1024;
+
+  class StateEncoder {
+  public:
+    // Writes one frame to out (maxFrameBytes) and returns its size. A delta is written only
+    // when keyframe is false and it can follow the previous frame (same game, time moving
+    // forward); keyframeWritten tells which one it was.
+    std::size_t encode (const TickState& state, bool keyframe, std::uint8_t* out,
+                        bool& keyframeWritten);
+    // The next frame will be a keyframe
+    void reset () {
+      hasPrevious_ = false;
+    }
+
+  private:
+    TickState previous_;
+    bool hasPrevious_ = false;
+  };
+
+  class StateDecoder {
+  public:
+    // Decodes one payload (without the size header) into state. False when it is corrupt or
+    // a delta without the frames before it, e.g. before the first keyframe.
+    bool decode (const std::uint8_t* payload, std::size_t size, TickState& state,
+                 bool& keyframe);
+    void reset () {
+      hasPrevious_ = false;
+    }
+
+  private:
+    TickState previous_;
+    bool hasPrevious_ = false;
+  };
+
+  // Payload size of the frame starting at data
+  inline std::size_t framePayloadSize (const std::uint8_t* data) {
+    return static_cast<std::size_t> (data[0]) | static_cast<std::size_t> (data[1]) << 8;
+  }
+
+} // namespace Spectator
+
+#endif // STATECODEC_HPP
@@ -0,0 +1,350 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Gameplay event capture in columnar chunks, flushed to a compact columnar file off thread
+
+#include "Telemetry.hpp"
+
+#include <Logger/Logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace Telemetry {
+
+  const std::array<Column, 8> eventColumns = { {
+      { "match", Column::Type::U64, Column::Encoding::DeltaVarint },
+      { "tick", Column::Type::U32, Column::Encoding::DeltaVarint },
+      { "type", Column::Type::U8, Column::Encoding::Raw },
+      { "x", Column::Type::I32, Column::Encoding::Varint },
+      { "y", Column::Type::I32, Column::Encoding::Varint },
+      { "paddle_offset", Column::Type::I32, Column::Encoding::Varint },
+      { "score", Column::Type::I32, Column::Encoding::DeltaVarint },
+      { "life", Column::Type::U8, Column::Encoding::Raw },
+  } };
+
+  namespace {
+    // Guards against reading a damaged row count as a huge allocation
+    constexpr std::uint32_t maxChunkRows = 1u << 24;
+    constexpr std::size_t magicBytes = sizeof (fileMagic) - 1;
+
+    void putU32 (std::vector<std::uint8_t>& out, std::size_t at, std::uint32_t value) {
+      for (int i = 0; i < 4; i++)
+        out[at + i] = static_cast<std::uint8_t> (value >> (8 * i));
+    }
+
+    std::uint32_t getU32 (const std::uint8_t* data) {
+      return static_cast<std::uint32_t> (data[0]) | static_cast<std::uint32_t> (data[1]) << 8
+             | static_cast<std::uint32_t> (data[2]) << 16
+             | static_cast<std::uint32_t> (data[3]) << 24;
+    }
+
+    void putVarint (std::vector<std::uint8_t>& out, std::int64_t value) {
+      std::uint64_t zigzag
+          = (static_cast<std::uint64_t> (value) << 1) ^ static_cast<std::uint64_t> (value >> 63);
+      while (zigzag >= 0x80) {
+        out.push_back (static_cast<std::uint8_t> (zigzag | 0x80));
+        zigzag >>= 7;
+      }
+      out.push_back (static_cast<std::uint8_t> (zigzag));
+    }
+
+    // Appends the u32 size and the values of one column, valueAt (row) for each row
+    template <typename ValueAt>
+    void encodeColumn (std::vector<std::uint8_t>& out, std::size_t rows,
+                       Column::Encoding encoding, ValueAt valueAt) {
+      const std::size_t sizeAt = out.size ();
+      out.resize (sizeAt + 4);
+      if (encoding == Column::Encoding::Raw) {
+        for (std::size_t i = 0; i < rows; i++)
+          out.push_back (static_cast<std::uint8_t> (valueAt (i)));
+      } else {
+        std::int64_t previous = 0;
+        for (std::size_t i = 0; i < rows; i++) {
+          const auto value = static_cast<std::int64_t> (valueAt (i));
+          putVarint (out, encoding == Column::Encoding::DeltaVarint ? value - previous : value);
+          previous = value;
+        }
+      }
+      putU32 (out, sizeAt, static_cast<std::uint32_t> (out.size () - sizeAt - 4));
+    }
+
+    bool decodeColumn (const std::uint8_t* data, std::size_t size, std::size_t rows,
+                       Column::Type type, Column::Encoding encoding,
+                       std::vector<std::int64_t>& values) {
+      values.resize (rows);
+      if (encoding == Column::Encoding::Raw) {
+        if (type != Column::Type::U8 || size != rows)
+          return false;
+        for (std::size_t i = 0; i < rows; i++)
+          values[i] = data[i];
+        return true;
+      }
+      std::size_t at = 0;
+      std::int64_t previous = 0;
+      for (std::size_t i = 0; i < rows; i++) {
+        std::uint64_t zigzag = 0;
+        int shift = 0;
+        std::uint8_t byte = 0x80;
+        while (byte & 0x80) {
+          if (at >= size || shift > 63)
+            return false;
+          byte = data[at++];
+          zigzag |= static_cast<std::uint64_t> (byte & 0x7f) << shift;
+          shift += 7;
+        }
+        std::int64_t value
+            = static_cast<std::int64_t> (zigzag >> 1) ^ -static_cast<std::int64_t> (zigzag & 1);
+        if (encoding == Column::Encoding::DeltaVarint)
+          value += previous;
+        values[i] = previous = value;
+      }
+      return at == size;
+    }
+
+    template <typename T>
+    void assignColumn (std::vector<T>& column, const std::vector<std::int64_t>& values) {
+      for (std::size_t i = 0; i < values.size (); i++)
+        column[i] = static_cast<T> (values[i]);
+    }
+
+    std::int32_t toSubpixels (float value) {
+      return static_cast<std::int32_t> (std::lround (value * subpixels));
+    }
+  } // namespace
+
+  TelemetryWriter::TelemetryWriter (std::size_t maxQueued)
+      : maxQueued_ (std::max<std::size_t> (1, maxQueued)) {
+  }
+
+  TelemetryWriter::~TelemetryWriter () {
+    close ();
+  }
+
+  bool TelemetryWriter::open (const std::filesystem::path& path) {
+    close ();
+    file_.open (path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file_) {
+      LOG_E_STREAM << "Telemetry: cannot write " << path << std::endl;
+      return false;
+    }
+    std::vector<std::uint8_t> header (fileMagic, fileMagic + magicBytes);
+    header.push_back (static_cast<std::uint8_t> (eventColumns.size ()));
+    for (const Column& column : eventColumns) {
+      const std::size_t length = std::strlen (column.name);
+      header.push_back (static_cast<std::uint8_t> (length));
+      header.insert (header.end (), column.name, column.name + length);
+      header.push_back (static_cast<std::uint8_t> (column.type));
+      header.push_back (static_cast<std::uint8_t> (column.encoding));
+    }
+    file_.write (reinterpret_cast<const char*> (header.data ()),
+                 static_cast<std::streamsize> (header.size ()));
+
+    std::lock_guard<std::mutex> lock (mutex_);
+    stats_ = WriterStats{};
+    stats_.bytes = header.size ();
+    closing_ = false;
+    thread_ = std::thread (&TelemetryWriter::flushLoop, this);
+    return true;
+  }
+
+  void TelemetryWriter::close () {
+    if (!thread_.joinable ())
+      return;
+    {
+      std::lock_guard<std::mutex> lock (mutex_);
+      closing_ = true;
+    }
+    queued_.notify_one ();
+    thread_.join ();
+    file_.close ();
+  }
+
+  std::unique_ptr<EventChunk> TelemetryWriter::exchange (std::unique_ptr<EventChunk> full) {
+    std::unique_lock<std::mutex> lock (mutex_);
+    if (full && full->rows > 0 && !closing_) {
+      if (queue_.size () >= maxQueued_) {
+        stats_.stalls++;
+        drained_.wait (lock, [&] { return queue_.size () < maxQueued_ || closing_; });
+      }
+      queue_.push_back (std::move (full));
+      queued_.notify_one ();
+    }
+    // Not queued: empty, or the file is closed and the events are dropped
+    std::unique_ptr<EventChunk> chunk = std::move (full);
+    if (!chunk && !spare_.empty ()) {
+      chunk = std::move (spare_.back ());
+      spare_.pop_back ();
+    }
+    lock.unlock ();
+    if (!chunk)
+      chunk = std::make_unique<EventChunk> ();
+    chunk->rows = 0;
+    return chunk;
+  }
+
+  WriterStats TelemetryWriter::stats () const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return stats_;
+  }
+
+  void TelemetryWriter::flushLoop () {
+    std::unique_lock<std::mutex> lock (mutex_);
+    while (true) {
+      queued_.wait (lock, [&] { return closing_ || !queue_.empty (); });
+      if (queue_.empty ())
+        return; // closing with everything written
+      std::unique_ptr<EventChunk> chunk = std::move (queue_.front ());
+      queue_.erase (queue_.begin ());
+      drained_.notify_all ();
+      lock.unlock ();
+      writeChunk (*chunk);
+      lock.lock ();
+      stats_.rows += chunk->rows;
+      stats_.chunks++;
+      stats_.bytes += encoded_.size ();
+      stats_.encodeNanoseconds += encodeNanoseconds_;
+      spare_.push_back (std::move (chunk));
+    }
+  }
+
+  void TelemetryWriter::writeChunk (const EventChunk& chunk) {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now ();
+    const std::size_t rows = chunk.rows;
+    encoded_.clear ();
+    encoded_.resize (4);
+    putU32 (encoded_, 0, static_cast<std::uint32_t> (rows));
+    // Same order as eventColumns
+    encodeColumn (encoded_, rows, eventColumns[0].encoding,
+                  [&] (std::size_t i) { return chunk.match[i]; });
+    encodeColumn (encoded_, rows, eventColumns[1].encoding,
+                  [&] (std::size_t i) { return chunk.tick[i]; });
+    encodeColumn (encoded_, rows, eventColumns[2].encoding,
+                  [&] (std::size_t i) { return chunk.type[i]; });
+    encodeColumn (encoded_, rows, eventColumns[3].encoding,
+                  [&] (std::size_t i) { return toSubpixels (chunk.x[i]); });
+    encodeColumn (encoded_, rows, eventColumns[4].encoding,
+                  [&] (std::size_t i) { return toSubpixels (chunk.y[i]); });
+    encodeColumn (encoded_, rows, eventColumns[5].encoding, [&] (std::size_t i) {
+      return chunk.type[i] == static_cast<std::uint8_t> (dotname::GameEventType::PaddleHit)
+                 ? toSubpixels (chunk.y[i] - chunk.paddleY[i])
+                 : 0;
+    });
+    encodeColumn (encoded_, rows, eventColumns[6].encoding,
+                  [&] (std::size_t i) { return chunk.score[i]; });
+    encodeColumn (encoded_, rows, eventColumns[7].encoding,
+                  [&] (std::size_t i) { return std::clamp (chunk.life[i], 0, 255); });
+    const auto elapsed
+        = std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now () - start);
+    encodeNanoseconds_ = static_cast<std::uint64_t> (elapsed.count ());
+    file_.write (reinterpret_cast<const char*> (encoded_.data ()),
+                 static_cast<std::streamsize> (encoded_.size ()));
+    file_.flush ();
+  }
+
+  TelemetryRecorder::TelemetryRecorder (TelemetryWriter& writer)
+      : writer_ (writer), chunk_ (writer.exchange (nullptr)) {
+  }
+
+  TelemetryRecorder::~TelemetryRecorder () {
+    if (chunk_->rows > 0)
+      writer_.exchange (std::move (chunk_));
+  }
+
+  void TelemetryRecorder::flush () {
+    if (chunk_->rows > 0)
+      chunk_ = writer_.exchange (std::move (chunk_));
+  }
+
+  bool TelemetryReader::open (const std::filesystem::path& path) {
+    file_.close ();
+    file_.clear ();
+    columns_.clear ();
+    failed_ = false;
+    file_.open (path, std::ios::in | std::ios::binary);
+    char magic[magicBytes];
+    unsigned char count = 0;
+    if (!file_.read (magic, magicBytes) || std::memcmp (magic, fileMagic, magicBytes) != 0
+        || !file_.read (reinterpret_cast<char*> (&count), 1)) {
+      failed_ = true;
+      return false;
+    }
+    for (unsigned i = 0; i < count; i++) {
+      unsigned char length = 0;
+      FileColumn column;
+      if (!file_.read (reinterpret_cast<char*> (&length), 1))
+        break;
+      column.name.resize (length);
+      unsigned char type = 0;
+      unsigned char encoding = 0;
+      if (!file_.read (column.name.data (), length)
+          || !file_.read (reinterpret_cast<char*> (&type), 1)
+          || !file_.read (reinterpret_cast<char*> (&encoding), 1)
+          || type > static_cast<unsigned char> (Column::Type::U64)
+          || encoding > static_cast<unsigned char> (Column::Encoding::DeltaVarint))
+        break;
+      column.type = static_cast<Column::Type> (type);
+      column.encoding = static_cast<Column::Encoding> (encoding);
+      columns_.push_back (std::move (column));
+    }
+    failed_ = columns_.size () != count;
+    return !failed_;
+  }
+
+  bool TelemetryReader::next (EventColumns& columns) {
+    std::uint8_t rowBytes[4];
+    if (failed_ || !file_.read (reinterpret_cast<char*> (rowBytes), 4))
+      return false; // a clean end of file leaves failed () unset
+    const std::uint32_t rows = getU32 (rowBytes);
+    if (rows > maxChunkRows) {
+      failed_ = true;
+      return false;
+    }
+    columns.rows = rows;
+    columns.match.assign (rows, 0);
+    columns.tick.assign (rows, 0);
+    columns.type.assign (rows, 0);
+    columns.x.assign (rows, 0);
+    columns.y.assign (rows, 0);
+    columns.paddleOffset.assign (rows, 0);
+    columns.score.assign (rows, 0);
+    columns.life.assign (rows, 0);
+
+    std::vector<std::int64_t> values;
+    for (const FileColumn& column : columns_) {
+      std::uint8_t sizeBytes[4];
+      if (!file_.read (reinterpret_cast<char*> (sizeBytes), 4)) {
+        failed_ = true;
+        return false;
+      }
+      buffer_.resize (getU32 (sizeBytes));
+      if (!file_.read (reinterpret_cast<char*> (buffer_.data ()),
+                       static_cast<std::streamsize> (buffer_.size ()))
+          || !decodeColumn (buffer_.data (), buffer_.size (), rows, column.type,
+                            column.encoding, values)) {
+        failed_ = true;
+        return false;
+      }
+      if (column.name == "match")
+        assignColumn (columns.match, values);
+      else if (column.name == "tick")
+        assignColumn (columns.tick, values);
+      else if (column.name == "type")
+        assignColumn (columns.type, values);
+      else if (column.name == "x")
+        assignColumn (columns.x, values);
+      else if (column.name == "y")
+        assignColumn (columns.y, values);
+      else if (column.name == "paddle_offset")
+        assignColumn (columns.paddleOffset, values);
+      else if (column.name == "score")
+        assignColumn (columns.score, values);
+      else if (column.name == "life")
+        assignColumn (columns.life, values);
+    }
+    return true;
+  }
+
+} // namespace Telemetry
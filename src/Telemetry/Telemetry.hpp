@@ -0,0 +1,196 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Gameplay event capture in columnar chunks, flushed to a compact columnar file off thread
+
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include <GameEngine/Simulation.hpp>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Telemetry {
+
+  // Positions are in 1/16 px, like the spectator stream
+  constexpr int subpixels = 16;
+
+  // One array per event field, holding the values as the simulation has them: rounding to
+  // subpixels, the paddle offset and clamping happen when the writer thread encodes the chunk,
+  // so recording a row is plain stores. Score and life are after the event.
+  struct EventChunk {
+    static constexpr std::size_t capacity = 8192;
+
+    std::array<std::uint64_t, capacity> match;
+    std::array<std::uint32_t, capacity> tick;
+    std::array<std::uint8_t, capacity> type; // dotname::GameEventType
+    std::array<float, capacity> x;
+    std::array<float, capacity> y;
+    std::array<float, capacity> paddleY; // player paddle centre
+    std::array<std::int32_t, capacity> score;
+    std::array<std::int32_t, capacity> life;
+    std::size_t rows = 0;
+  };
+
+  struct WriterStats {
+    std::uint64_t rows = 0;
+    std::uint64_t chunks = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t stalls = 0; // chunks handed over while the flush queue was full
+    std::uint64_t encodeNanoseconds = 0; // writer thread time spent encoding chunks
+  };
+
+  // File layout, little endian throughout:
+  //   header  "PONGEVT1", u8 column count, then per column: u8 name length, name,
+  //           u8 type (Column::Type), u8 encoding (Column::Encoding)
+  //   chunks  u32 rows, then per column in header order: u32 byte size, encoded values
+  // Integers are zigzag LEB128 varints, optionally as differences from the previous row of
+  // the chunk. Chunks decode independently, so a file cut short loses only its last chunk.
+  // paddle_offset is where a paddle hit landed relative to the paddle centre (negative
+  // above), 0 for other events.
+  struct Column {
+    enum class Type : std::uint8_t { U8, I32, U32, U64 };
+    enum class Encoding : std::uint8_t { Raw, Varint, DeltaVarint };
+    const char* name;
+    Type type;
+    Encoding encoding;
+  };
+  extern const std::array<Column, 8> eventColumns;
+  constexpr char fileMagic[] = "PONGEVT1";
+
+  // Owns the file and a thread that encodes and writes full chunks. Chunks are recycled, so
+  // a steady stream of events allocates nothing.
+  class TelemetryWriter {
+  public:
+    // Chunks waiting for the disk before handing over another one blocks
+    explicit TelemetryWriter (std::size_t maxQueued = 16);
+    ~TelemetryWriter ();
+
+    TelemetryWriter (const TelemetryWriter&) = delete;
+    TelemetryWriter& operator= (const TelemetryWriter&) = delete;
+
+    // Truncates path and writes the header; false (with a logged reason) when it cannot
+    bool open (const std::filesystem::path& path);
+    // Writes every chunk handed over so far and closes the file
+    void close ();
+    bool isOpen () const {
+      return thread_.joinable ();
+    }
+
+    // Queues full (when not empty) for writing and returns an empty chunk
+    std::unique_ptr<EventChunk> exchange (std::unique_ptr<EventChunk> full);
+
+    WriterStats stats () const;
+
+  private:
+    void flushLoop ();
+    void writeChunk (const EventChunk& chunk);
+
+    std::size_t maxQueued_;
+    std::ofstream file_;
+    std::vector<std::uint8_t> encoded_;
+    std::uint64_t encodeNanoseconds_ = 0; // of the last chunk, writer thread only
+    std::vector<std::unique_ptr<EventChunk>> queue_;
+    std::vector<std::unique_ptr<EventChunk>> spare_;
+    mutable std::mutex mutex_;
+    std::condition_variable queued_;
+    std::condition_variable drained_;
+    bool closing_ = true; // also while not open, so chunks handed over are dropped
+    std::thread thread_;
+    WriterStats stats_;
+  };
+
+  // Fills chunks for one thread (an engine or a tournament worker) and hands them to the
+  // writer when full. Ticks without events return after one comparison.
+  class TelemetryRecorder {
+  public:
+    explicit TelemetryRecorder (TelemetryWriter& writer);
+    // Hands over the partly filled chunk
+    ~TelemetryRecorder ();
+
+    TelemetryRecorder (const TelemetryRecorder&) = delete;
+    TelemetryRecorder& operator= (const TelemetryRecorder&) = delete;
+
+    // Events of one step of the match's simulation. Inline and without conversions, it runs
+    // in the simulation loop.
+    template <typename Simulation>
+    void record (std::uint64_t match, const Simulation& simulation,
+                 const dotname::GameEvents& events) {
+      if (events.count == 0)
+        return;
+      using Traits = typename Simulation::Traits;
+      const float paddleY = Traits::toVector2 (simulation.player.position).y;
+      for (const dotname::GameEvent& event : events) {
+        if (chunk_->rows == EventChunk::capacity)
+          chunk_ = writer_.exchange (std::move (chunk_));
+        EventChunk& chunk = *chunk_;
+        const std::size_t row = chunk.rows++;
+        chunk.match[row] = match;
+        chunk.tick[row] = static_cast<std::uint32_t> (simulation.tick);
+        chunk.type[row] = static_cast<std::uint8_t> (event.type);
+        chunk.x[row] = event.position.x;
+        chunk.y[row] = event.position.y;
+        chunk.paddleY[row] = paddleY;
+        chunk.score[row] = simulation.score;
+        chunk.life[row] = simulation.player.life;
+      }
+    }
+
+    void flush ();
+
+  private:
+
+    TelemetryWriter& writer_;
+    std::unique_ptr<EventChunk> chunk_;
+  };
+
+  // Decoded columns of one chunk, for analysis
+  struct EventColumns {
+    std::vector<std::uint64_t> match;
+    std::vector<std::uint32_t> tick;
+    std::vector<std::uint8_t> type;
+    std::vector<std::int32_t> x;
+    std::vector<std::int32_t> y;
+    std::vector<std::int32_t> paddleOffset;
+    std::vector<std::int32_t> score;
+    std::vector<std::uint8_t> life;
+    std::size_t rows = 0;
+  };
+
+  // Reads files written by TelemetryWriter chunk by chunk. Columns the reader does not know
+  // are skipped, and ones missing from the file read as zeros.
+  class TelemetryReader {
+  public:
+    bool open (const std::filesystem::path& path);
+    // False at the end of the file, or when the next chunk is damaged (failed () is set)
+    bool next (EventColumns& columns);
+    bool failed () const {
+      return failed_;
+    }
+
+  private:
+    struct FileColumn {
+      std::string name;
+      Column::Type type;
+      Column::Encoding encoding;
+    };
+
+    std::ifstream file_;
+    std::vector<FileColumn> columns_;
+    std::vector<std::uint8_t> buffer_;
+    bool failed_ = false;
+  };
+
+} // namespace Telemetry
+
+#endif // TELEMETRY_HPP
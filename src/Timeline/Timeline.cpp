@@ -0,0 +1,239 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Cooperative timelines of actions and waits, advanced once per frame without threads
+
+#include "Timeline.hpp"
+
+#include <algorithm>
+
+namespace Timeline {
+
+  namespace {
+    // Cancelled sleepers left in the heap before it is worth rebuilding
+    constexpr std::size_t minStaleTimers = 64;
+  } // namespace
+
+  Sequence& Sequence::call (Action action) {
+    steps_.push_back (Step{ Kind::Call, Duration{}, std::move (action), {} });
+    return *this;
+  }
+
+  Sequence& Sequence::wait (Duration duration) {
+    steps_.push_back (Step{ Kind::Wait, duration, {}, {} });
+    return *this;
+  }
+
+  Sequence& Sequence::waitUntil (Condition condition) {
+    steps_.push_back (Step{ Kind::WaitUntil, Duration{}, {}, std::move (condition) });
+    return *this;
+  }
+
+  Scheduler::Handle Scheduler::start (std::shared_ptr<const Sequence> sequence,
+                                      std::uint64_t tag) {
+    if (!sequence)
+      return 0;
+    std::uint32_t index;
+    if (free_.empty ()) {
+      index = static_cast<std::uint32_t> (instances_.size ());
+      instances_.emplace_back ();
+    } else {
+      index = free_.back ();
+      free_.pop_back ();
+    }
+    Instance& instance = instances_[index];
+    instance.sequence = std::move (sequence);
+    instance.tag = tag;
+    instance.step = 0;
+    instance.state = State::Running;
+    running_++;
+    const Handle handle = (static_cast<Handle> (instance.generation) << 32) | index;
+    run (index, now_);
+    return handle;
+  }
+
+  void Scheduler::cancel (Handle handle) {
+    const std::uint32_t index = static_cast<std::uint32_t> (handle);
+    if (!current (index, static_cast<std::uint32_t> (handle >> 32)))
+      return;
+    // The heap and poll list entries go stale and are skipped
+    switch (instances_[index].state) {
+    case State::Sleeping:
+      sleeping_--;
+      staleTimers_++;
+      break;
+    case State::Polling:
+      pollingCount_--;
+      break;
+    default:
+      break;
+    }
+    finish (index);
+  }
+
+  bool Scheduler::running (Handle handle) const {
+    return current (static_cast<std::uint32_t> (handle), static_cast<std::uint32_t> (handle >> 32));
+  }
+
+  void Scheduler::clear () {
+    free_.clear ();
+    released_.clear ();
+    for (std::uint32_t index = 0; index < instances_.size (); index++) {
+      Instance& instance = instances_[index];
+      if (instance.state != State::Free && ++instance.generation == 0)
+        instance.generation = 1;
+      instance.state = State::Free;
+      instance.sequence.reset ();
+      free_.push_back (index);
+    }
+    timers_.clear ();
+    polling_.clear ();
+    staleTimers_ = 0;
+    running_ = 0;
+    sleeping_ = 0;
+    pollingCount_ = 0;
+  }
+
+  void Scheduler::reserve (std::size_t timelines) {
+    instances_.reserve (timelines);
+    free_.reserve (timelines);
+    released_.reserve (timelines);
+    timers_.reserve (timelines);
+    polling_.reserve (timelines);
+    polled_.reserve (timelines);
+  }
+
+  void Scheduler::advance (Duration elapsed) {
+    now_ += elapsed;
+    depth_++; // conditions are called from here as well as from run ()
+
+    while (!timers_.empty () && timers_.front ().wake <= now_) {
+      std::pop_heap (timers_.begin (), timers_.end ());
+      const Timer timer = timers_.back ();
+      timers_.pop_back ();
+      if (!current (timer.index, timer.generation)) {
+        staleTimers_ -= staleTimers_ > 0 ? 1 : 0;
+        continue;
+      }
+      instances_[timer.index].state = State::Running;
+      sleeping_--;
+      run (timer.index, timer.wake);
+    }
+
+    // Timelines that start polling from here on are checked from the next advance ()
+    polled_.swap (polling_);
+    for (const Poll& poll : polled_) {
+      if (!current (poll.index, poll.generation))
+        continue;
+      const Instance& instance = instances_[poll.index];
+      const bool ready = instance.sequence->steps_[instance.step].condition (instance.tag);
+      if (!current (poll.index, poll.generation))
+        continue; // the condition cancelled its own timeline
+      if (!ready) {
+        polling_.push_back (poll);
+        continue;
+      }
+      Instance& resumed = instances_[poll.index];
+      resumed.step++;
+      resumed.state = State::Running;
+      pollingCount_--;
+      run (poll.index, now_);
+    }
+    polled_.clear ();
+    releaseSlots ();
+
+    if (staleTimers_ > minStaleTimers && staleTimers_ * 2 > timers_.size ())
+      compactTimers ();
+  }
+
+  SchedulerStats Scheduler::stats () const {
+    SchedulerStats stats;
+    stats.running = running_;
+    stats.sleeping = sleeping_;
+    stats.polling = pollingCount_;
+    stats.stepsRun = stepsRun_;
+    return stats;
+  }
+
+  void Scheduler::run (std::uint32_t index, Duration at) {
+    depth_++;
+    runSteps (index, at);
+    releaseSlots ();
+  }
+
+  void Scheduler::releaseSlots () {
+    if (--depth_ > 0)
+      return;
+    free_.insert (free_.end (), released_.begin (), released_.end ());
+    released_.clear ();
+  }
+
+  void Scheduler::runSteps (std::uint32_t index, Duration at) {
+    // Actions and conditions may start timelines, which can move instances_: every step
+    // looks its timeline up again
+    for (;;) {
+      Instance& instance = instances_[index];
+      const std::vector<Sequence::Step>& steps = instance.sequence->steps_;
+      if (instance.step >= steps.size ()) {
+        finish (index);
+        return;
+      }
+      const Sequence::Step& step = steps[instance.step];
+      const std::uint32_t generation = instance.generation;
+      stepsRun_++;
+      switch (step.kind) {
+      case Sequence::Kind::Call:
+        instance.step++;
+        step.action (instance.tag);
+        if (!current (index, generation))
+          return;
+        break;
+      case Sequence::Kind::Wait:
+        instance.step++;
+        at += step.duration;
+        if (at <= now_)
+          break; // due already, e.g. after a long frame
+        instance.state = State::Sleeping;
+        sleeping_++;
+        timers_.push_back (Timer{ at, timerOrder_++, index, generation });
+        std::push_heap (timers_.begin (), timers_.end ());
+        return;
+      case Sequence::Kind::WaitUntil: {
+        const bool ready = step.condition (instance.tag);
+        if (!current (index, generation))
+          return;
+        if (ready) {
+          instances_[index].step++;
+          break;
+        }
+        instances_[index].state = State::Polling;
+        pollingCount_++;
+        polling_.push_back (Poll{ index, generation });
+        return;
+      }
+      }
+    }
+  }
+
+  void Scheduler::finish (std::uint32_t index) {
+    // The sequence stays referenced until the slot is reused, and a slot freed while steps
+    // run is reused only after they return: the action running may be the sequence's last
+    // reference
+    Instance& instance = instances_[index];
+    instance.state = State::Free;
+    if (++instance.generation == 0)
+      instance.generation = 1; // handle 0 is never valid
+    running_--;
+    (depth_ > 0 ? released_ : free_).push_back (index);
+  }
+
+  void Scheduler::compactTimers () {
+    timers_.erase (std::remove_if (timers_.begin (), timers_.end (),
+                                   [this] (const Timer& timer) {
+                                     return !current (timer.index, timer.generation);
+                                   }),
+                   timers_.end ());
+    std::make_heap (timers_.begin (), timers_.end ());
+    staleTimers_ = 0;
+  }
+
+} // namespace Timeline
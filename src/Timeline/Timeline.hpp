@@ -0,0 +1,137 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Cooperative timelines of actions and waits, advanced once per frame without threads
+
+#ifndef TIMELINE_HPP
+#define TIMELINE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Timeline {
+
+  using Duration = std::chrono::steady_clock::duration;
+
+  // Steps run in order: actions, waits for a time and waits for a condition. Built once and
+  // shared by every timeline playing it; tag is the value the timeline was started with, so
+  // one sequence can drive many targets (a timer per power-up, say).
+  class Sequence {
+  public:
+    using Action = std::function<void (std::uint64_t tag)>;
+    using Condition = std::function<bool (std::uint64_t tag)>;
+
+    Sequence& call (Action action);
+    Sequence& wait (Duration duration);
+    // Checked once per frame until it holds, e.g. a key press
+    Sequence& waitUntil (Condition condition);
+
+    std::size_t size () const {
+      return steps_.size ();
+    }
+
+  private:
+    friend class Scheduler;
+    enum class Kind : std::uint8_t { Call, Wait, WaitUntil };
+    struct Step {
+      Kind kind;
+      Duration duration;
+      Action action;
+      Condition condition;
+    };
+    std::vector<Step> steps_;
+  };
+
+  struct SchedulerStats {
+    std::size_t running = 0;  // started and not finished or cancelled
+    std::size_t sleeping = 0; // of those, waiting for a time (not touched until it is due)
+    std::size_t polling = 0;  // waiting for a condition, checked every advance ()
+    std::uint64_t stepsRun = 0;
+  };
+
+  // Runs timelines as small state machines: a timeline runs its steps until it reaches a wait,
+  // then sleeps in a heap ordered by wake time or on the list of conditions to poll. advance ()
+  // touches only the timelines that are due and the polling ones, so thousands of sleeping
+  // timers cost nothing per frame. Waits count from when the previous wait was due, not from
+  // when the frame ran it, so a sequence keeps its rhythm at any frame rate and catches up
+  // after a long frame. Single threaded: actions may start and cancel timelines.
+  class Scheduler {
+  public:
+    // Identifies one run of a sequence; stays invalid once it has finished
+    using Handle = std::uint64_t;
+
+    Handle start (std::shared_ptr<const Sequence> sequence, std::uint64_t tag = 0);
+    void cancel (Handle handle);
+    bool running (Handle handle) const;
+    // Cancels every timeline; not from inside an action or condition
+    void clear ();
+    // Room for this many timelines at once, so starting them does not allocate
+    void reserve (std::size_t timelines);
+
+    // Moves the timeline clock by the frame time and runs everything that became due
+    void advance (Duration elapsed);
+    Duration now () const {
+      return now_;
+    }
+
+    SchedulerStats stats () const;
+
+  private:
+    enum class State : std::uint8_t { Free, Running, Sleeping, Polling };
+    struct Instance {
+      std::shared_ptr<const Sequence> sequence;
+      std::uint64_t tag = 0;
+      std::uint32_t step = 0;
+      std::uint32_t generation = 1;
+      State state = State::Free;
+    };
+    struct Timer {
+      Duration wake;
+      std::uint64_t order; // among equal wake times, the one put to sleep first runs first
+      std::uint32_t index;
+      std::uint32_t generation;
+      // std::push_heap keeps the largest on top, so the largest is the earliest
+      bool operator< (const Timer& other) const {
+        return wake != other.wake ? wake > other.wake : order > other.order;
+      }
+    };
+    struct Poll {
+      std::uint32_t index;
+      std::uint32_t generation;
+    };
+
+    bool current (std::uint32_t index, std::uint32_t generation) const {
+      return index < instances_.size () && instances_[index].state != State::Free
+             && instances_[index].generation == generation;
+    }
+    // Runs the steps of a timeline from its current step as of time at
+    void run (std::uint32_t index, Duration at);
+    void runSteps (std::uint32_t index, Duration at);
+    // Ends a run () or advance (); the outermost one makes the released slots reusable
+    void releaseSlots ();
+    void finish (std::uint32_t index);
+    // Drops the heap entries of cancelled timelines once they are most of it
+    void compactTimers ();
+
+    std::vector<Instance> instances_;
+    std::vector<std::uint32_t> free_;
+    std::vector<std::uint32_t> released_; // freed while steps run, see finish ()
+    int depth_ = 0;                       // run () calls in progress
+    std::vector<Timer> timers_; // heap
+    std::vector<Poll> polling_;
+    std::vector<Poll> polled_; // polling_ of the previous advance (), reused
+    Duration now_{};
+    std::uint64_t timerOrder_ = 0;
+    std::size_t staleTimers_ = 0;
+    std::size_t running_ = 0;
+    std::size_t sleeping_ = 0;
+    std::size_t pollingCount_ = 0;
+    std::uint64_t stepsRun_ = 0;
+  };
+
+} // namespace Timeline
+
+#endif // TIMELINE_HPP
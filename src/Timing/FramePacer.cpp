@@ -0,0 +1,74 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Adaptive frame rate governor with event driven idle mode
+
+#include "FramePacer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <raylib.h>
+
+namespace Timing {
+
+  namespace {
+    // Weight of the newest frame in the work average
+    constexpr double workSmoothing = 0.05;
+    // Rate changes smaller than this are ignored so the target does not flicker
+    constexpr int fpsHysteresis = 5;
+  } // namespace
+
+  FramePacer::FramePacer (const PacingConfig& config) : config_ (config) {
+    config_.maxFps = std::max (1, config_.maxFps);
+    config_.minFps = std::clamp (config_.minFps, 1, config_.maxFps);
+  }
+
+  void FramePacer::start () {
+    stats_.targetFps = config_.maxFps;
+    SetTargetFPS (stats_.targetFps);
+  }
+
+  void FramePacer::frameDone (double workSeconds, double intervalSeconds, bool idle) {
+    stats_.framesRendered++;
+    if (stats_.averageWork == 0.0)
+      stats_.averageWork = workSeconds;
+    else
+      stats_.averageWork += (workSeconds - stats_.averageWork) * workSmoothing;
+
+    // Everything the full rate would have drawn in the last interval beyond this one frame
+    const double wouldDraw = intervalSeconds * config_.maxFps;
+    if (wouldDraw > 1.0) {
+      skipped_ += wouldDraw - 1.0;
+      stats_.framesSkipped = static_cast<std::uint64_t> (skipped_);
+      stats_.cpuSecondsSaved += (wouldDraw - 1.0) * stats_.averageWork;
+    }
+
+    if (config_.idleThrottle && idle != stats_.idle) {
+      if (idle)
+        EnableEventWaiting ();
+      else
+        DisableEventWaiting ();
+      stats_.idle = idle;
+    }
+
+    int target = config_.maxFps;
+    if (config_.powerBudget > 0.0 && stats_.averageWork > 0.0) {
+      const double affordable = config_.powerBudget / stats_.averageWork;
+      target = static_cast<int> (std::min<double> (config_.maxFps, affordable));
+    }
+    target = std::clamp (target, config_.minFps, config_.maxFps);
+    if (std::abs (target - stats_.targetFps) >= fpsHysteresis
+        || (target == config_.maxFps && stats_.targetFps != target)) {
+      stats_.targetFps = target;
+      SetTargetFPS (target);
+    }
+  }
+
+  void FramePacer::stop () {
+    if (stats_.idle) {
+      DisableEventWaiting ();
+      stats_.idle = false;
+    }
+  }
+
+} // namespace Timing
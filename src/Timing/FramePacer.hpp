@@ -0,0 +1,58 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Adaptive frame rate governor with event driven idle mode
+
+#ifndef FRAMEPACER_HPP
+#define FRAMEPACER_HPP
+
+#include <cstdint>
+
+namespace Timing {
+
+  struct PacingConfig {
+    int maxFps = 120;
+    int minFps = 30;
+    // Share of one core the frame work may use (1 = no limit below maxFps)
+    double powerBudget = 1.0;
+    // Block on input instead of redrawing while the screen is static
+    bool idleThrottle = true;
+  };
+
+  struct PacingStats {
+    std::uint64_t framesRendered = 0;
+    std::uint64_t framesSkipped = 0; // frames maxFps would have drawn that were not drawn
+    double cpuSecondsSaved = 0.0;    // skipped frames times the average frame work
+    double averageWork = 0.0;        // seconds of update and draw per frame (moving average)
+    int targetFps = 0;
+    bool idle = false;
+  };
+
+  // Picks the frame rate every frame: the configured maximum, lowered when the measured frame
+  // work would exceed the power budget, and event driven (no redraw until input) while the
+  // caller reports nothing on screen can change. Input wakes the loop and the next frame
+  // restores the full rate.
+  class FramePacer {
+  public:
+    explicit FramePacer (const PacingConfig& config = {});
+
+    // Applies the initial target frame rate
+    void start ();
+    // workSeconds: update and draw time of the frame just submitted; intervalSeconds: time
+    // between the last two frame starts; idle: the next frames would look the same
+    void frameDone (double workSeconds, double intervalSeconds, bool idle);
+    // Leaves event waiting so shutdown or other loops are not blocked
+    void stop ();
+
+    const PacingStats& stats () const {
+      return stats_;
+    }
+
+  private:
+    PacingConfig config_;
+    PacingStats stats_;
+    double skipped_ = 0.0; // fractional, frame intervals jitter around the cap
+  };
+
+} // namespace Timing
+
+#endif // FRAMEPACER_HPP
@@ -0,0 +1,119 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Paddle controller policies for headless play
+
+#include "Policies.hpp"
+
+#include <cmath>
+
+namespace Tournament {
+
+  namespace {
+    using dotname::PaddleInput;
+
+    PaddleInput moveTowards (const CourtView& court, float targetY, float deadZone) {
+      PaddleInput input;
+      input.launch = !court.ball.active;
+      const float delta = targetY - court.player.position.y;
+      input.up = delta < -deadZone;
+      input.down = delta > deadZone;
+      return input;
+    }
+
+    // Launches and never moves
+    class IdlePolicy : public PaddlePolicy {
+    public:
+      PaddleInput decide (const CourtView& court) override {
+        PaddleInput input;
+        input.launch = !court.ball.active;
+        return input;
+      }
+    };
+
+    // Keeps the paddle centre on the ball
+    class TrackerPolicy : public PaddlePolicy {
+    public:
+      PaddleInput decide (const CourtView& court) override {
+        return moveTowards (court, court.ball.position.y, 2.0f);
+      }
+    };
+
+    // Tracks only an approaching ball, otherwise drifts back to the centre
+    class LazyPolicy : public PaddlePolicy {
+    public:
+      PaddleInput decide (const CourtView& court) override {
+        const float target
+            = court.ball.speed.x < 0 ? court.ball.position.y : court.courtHeight / 2.0f;
+        return moveTowards (court, target, 4.0f);
+      }
+    };
+
+    // Waits where the ball will cross the paddle face, unfolding wall reflections
+    class PredictorPolicy : public PaddlePolicy {
+    public:
+      PaddleInput decide (const CourtView& court) override {
+        const auto& ball = court.ball;
+        const auto& player = court.player;
+        if (!ball.active || ball.speed.x == 0.0f)
+          return moveTowards (court, ball.position.y, 2.0f);
+
+        const float radius = static_cast<float> (ball.radius);
+        const float face = player.position.x + player.size.x / 2 + radius;
+        const float far = court.courtWidth - radius;
+        const float distance = ball.speed.x < 0 ? ball.position.x - face
+                                                : (far - ball.position.x) + (far - face);
+        const float y = ball.position.y + ball.speed.y * (distance / std::fabs (ball.speed.x));
+
+        // Fold the straight line back into the court between the top and bottom walls
+        const float span = court.courtHeight - 2 * radius;
+        float folded = std::fmod (y - radius, 2 * span);
+        if (folded < 0)
+          folded += 2 * span;
+        const float target = radius + (folded > span ? 2 * span - folded : folded);
+        return moveTowards (court, target, 2.0f);
+      }
+    };
+
+    // Tracker that misses a quarter of its decisions and repeats the previous one
+    class JitteryPolicy : public PaddlePolicy {
+    public:
+      void reset (std::uint64_t seed) override {
+        random_ = SplitMix64 (seed ^ 0x6a177e7ull);
+        last_ = PaddleInput{};
+      }
+      PaddleInput decide (const CourtView& court) override {
+        if ((random_.next () & 3) != 0)
+          last_ = moveTowards (court, court.ball.position.y, 2.0f);
+        return last_;
+      }
+
+    private:
+      SplitMix64 random_;
+      PaddleInput last_;
+    };
+
+    template <typename T> std::unique_ptr<PaddlePolicy> create () {
+      return std::make_unique<T> ();
+    }
+  } // namespace
+
+  const std::vector<PolicyInfo>& builtinPolicies () {
+    static const std::vector<PolicyInfo> policies = {
+      { "idle", "launches and never moves", &create<IdlePolicy> },
+      { "tracker", "follows the ball", &create<TrackerPolicy> },
+      { "lazy", "follows only an approaching ball", &create<LazyPolicy> },
+      { "predictor", "moves to the predicted intercept", &create<PredictorPolicy> },
+      { "jittery", "tracker that skips a quarter of its decisions", &create<JitteryPolicy> },
+    };
+    return policies;
+  }
+
+  const PolicyInfo* findPolicy (std::string_view name) {
+    for (const auto& policy : builtinPolicies ()) {
+      if (name == policy.name)
+        return &policy;
+    }
+    return nullptr;
+  }
+
+} // namespace Tournament
@@ -0,0 +1,75 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Paddle controller policies for headless play
+
+#ifndef POLICIES_HPP
+#define POLICIES_HPP
+
+#include <GameEngine/Simulation.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace Tournament {
+
+  // What a policy sees of a game, the same whichever rules the simulation compiles in
+  struct CourtView {
+    const dotname::Player& player;
+    const dotname::Ball& ball;
+    int courtWidth;
+    int courtHeight;
+  };
+
+  class PaddlePolicy {
+  public:
+    virtual ~PaddlePolicy () = default;
+    // Called before every game with the match seed
+    virtual void reset (std::uint64_t seed) {
+      (void)seed;
+    }
+    virtual dotname::PaddleInput decide (const CourtView& court) = 0;
+
+    // Any float simulation, runtime or compile time rules
+    template <typename Simulation> dotname::PaddleInput decide (const Simulation& simulation) {
+      return decide (CourtView{ simulation.player, simulation.ball, simulation.courtWidth,
+                                simulation.courtHeight });
+    }
+  };
+
+  using PolicyFactory = std::unique_ptr<PaddlePolicy> (*) ();
+
+  struct PolicyInfo {
+    const char* name;
+    const char* description;
+    PolicyFactory create;
+  };
+
+  const std::vector<PolicyInfo>& builtinPolicies ();
+  // nullptr when no policy has that name
+  const PolicyInfo* findPolicy (std::string_view name);
+
+  // Small deterministic generator (splitmix64), identical on every platform
+  class SplitMix64 {
+  public:
+    explicit SplitMix64 (std::uint64_t seed = 0) : state_ (seed) {
+    }
+    std::uint64_t next () {
+      std::uint64_t z = (state_ += 0x9e3779b97f4a7c15ull);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      return z ^ (z >> 31);
+    }
+    // Uniform in [lo, hi)
+    float uniform (float lo, float hi) {
+      return lo + (hi - lo) * static_cast<float> (next () >> 40) * (1.0f / 16777216.0f);
+    }
+
+  private:
+    std::uint64_t state_;
+  };
+
+} // namespace Tournament
+
+#endif // POLICIES_HPP
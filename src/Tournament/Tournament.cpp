@@ -0,0 +1,337 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Headless round robin / Swiss tournament between paddle policies with an Elo ladder
+
+#include "Tournament.hpp"
+
+#include <Telemetry/Telemetry.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "fmt/core.h"
+
+namespace Tournament {
+
+  namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Pairing {
+      std::size_t a;
+      std::size_t b;
+      std::uint64_t seed;
+    };
+
+    struct GameResult {
+      int score = 0;
+      int life = 0;
+      std::uint64_t ticks = 0;
+    };
+
+    struct PolicyCost {
+      std::uint64_t decisions = 0;
+      std::uint64_t sampled = 0;
+      std::uint64_t nanoseconds = 0; // of the sampled decisions, timer included
+    };
+
+    // Mean cost of an empty pair of clock reads, taken off the sampled decision times
+    double timerOverheadNanoseconds () {
+      constexpr int pairs = 10000;
+      std::chrono::nanoseconds total{};
+      for (int i = 0; i < pairs; i++) {
+        const auto start = Clock::now ();
+        total += Clock::now () - start;
+      }
+      return static_cast<double> (total.count ()) / pairs;
+    }
+
+    struct MatchResult {
+      GameResult a;
+      GameResult b;
+    };
+
+    bool sameRules (const dotname::Rules& a, const dotname::Rules& b) {
+      return a.courtWidth == b.courtWidth && a.courtHeight == b.courtHeight
+             && a.maxLife == b.maxLife && a.paddleX == b.paddleX
+             && a.paddleWidth == b.paddleWidth && a.paddleHeight == b.paddleHeight
+             && a.paddleSpeed == b.paddleSpeed && a.launchSpeed == b.launchSpeed
+             && a.deflection == b.deflection && a.ballRadius == b.ballRadius;
+    }
+
+    // telemetry may be null; game numbers the recorded events
+    template <typename Simulation>
+    GameResult playGame (Simulation simulation, const PolicyInfo& info, std::uint64_t seed,
+                         const TournamentConfig& config, PolicyCost& cost,
+                         Telemetry::TelemetryRecorder* telemetry, std::uint64_t game) {
+      auto policy = info.create ();
+      policy->reset (seed);
+      SplitMix64 serves (seed);
+
+      while (!simulation.gameOver && simulation.tick < config.maxTicks) {
+        dotname::PaddleInput input;
+        if (cost.decisions++ % decisionSampleInterval == 0) {
+          const auto start = Clock::now ();
+          input = policy->decide (simulation);
+          cost.nanoseconds += static_cast<std::uint64_t> (
+              std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now () - start)
+                  .count ());
+          cost.sampled++;
+        } else {
+          input = policy->decide (simulation);
+        }
+
+        const bool served = !simulation.ball.active;
+        const dotname::GameEvents& events = simulation.Step (input);
+        if (telemetry)
+          telemetry->record (game, simulation, events);
+        // Serve angles come from the match seed, so both sides of a match face the same ones
+        if (served && simulation.ball.active)
+          simulation.ball.speed.y = serves.uniform (-4.0f, 4.0f);
+      }
+      return GameResult{ simulation.score, simulation.player.life, simulation.tick };
+    }
+
+    // Named rule sets play on simulations with the rules compiled in; only custom rules
+    // (overrides, sweeps) pay for runtime rules
+    GameResult playGame (const PolicyInfo& info, std::uint64_t seed,
+                         const TournamentConfig& config, PolicyCost& cost,
+                         Telemetry::TelemetryRecorder* telemetry, std::uint64_t game) {
+      if (sameRules (config.rules, dotname::ClassicRuleSet::value))
+        return playGame (dotname::ClassicSimulation{}, info, seed, config, cost, telemetry, game);
+      if (sameRules (config.rules, dotname::ArcadeRuleSet::value))
+        return playGame (dotname::ArcadeSimulation{}, info, seed, config, cost, telemetry, game);
+      return playGame (dotname::Simulation (config.rules), info, seed, config, cost, telemetry,
+                       game);
+    }
+
+    // 1 when a wins, 0.5 on a draw, 0 when b wins
+    double matchScore (const MatchResult& result) {
+      if (result.a.score != result.b.score)
+        return result.a.score > result.b.score ? 1.0 : 0.0;
+      if (result.a.life != result.b.life)
+        return result.a.life > result.b.life ? 1.0 : 0.0;
+      return 0.5;
+    }
+
+    // Plays every pairing on all workers; results keep the pairing order so the Elo
+    // ladder does not depend on scheduling.
+    std::vector<MatchResult> playMatches (const std::vector<Pairing>& pairings,
+                                          const std::vector<const PolicyInfo*>& policies,
+                                          const TournamentConfig& config, unsigned int threads,
+                                          std::vector<PolicyCost>& costs,
+                                          Telemetry::TelemetryWriter* telemetry,
+                                          std::uint64_t firstGame) {
+      std::vector<MatchResult> results (pairings.size ());
+      std::vector<std::vector<PolicyCost>> workerCosts (threads,
+                                                        std::vector<PolicyCost> (policies.size ()));
+      std::atomic<std::size_t> next{ 0 };
+
+      auto worker = [&] (unsigned int id) {
+        auto& cost = workerCosts[id];
+        std::unique_ptr<Telemetry::TelemetryRecorder> recorder;
+        if (telemetry)
+          recorder = std::make_unique<Telemetry::TelemetryRecorder> (*telemetry);
+        for (std::size_t i = next++; i < pairings.size (); i = next++) {
+          const Pairing& pairing = pairings[i];
+          const std::uint64_t game = firstGame + 2 * i;
+          results[i].a = playGame (*policies[pairing.a], pairing.seed, config, cost[pairing.a],
+                                   recorder.get (), game);
+          results[i].b = playGame (*policies[pairing.b], pairing.seed, config, cost[pairing.b],
+                                   recorder.get (), game + 1);
+        }
+      };
+
+      std::vector<std::thread> pool;
+      for (unsigned int id = 1; id < threads; id++) {
+        pool.emplace_back (worker, id);
+      }
+      worker (0);
+      for (auto& thread : pool) {
+        thread.join ();
+      }
+
+      for (const auto& perWorker : workerCosts) {
+        for (std::size_t p = 0; p < costs.size (); p++) {
+          costs[p].decisions += perWorker[p].decisions;
+          costs[p].sampled += perWorker[p].sampled;
+          costs[p].nanoseconds += perWorker[p].nanoseconds;
+        }
+      }
+      return results;
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>>
+    swissPairings (const std::vector<Standing>& standings,
+                   const std::set<std::pair<std::size_t, std::size_t>>& played) {
+      std::vector<std::size_t> order (standings.size ());
+      for (std::size_t i = 0; i < order.size (); i++) {
+        order[i] = i;
+      }
+      std::stable_sort (order.begin (), order.end (), [&] (std::size_t l, std::size_t r) {
+        return standings[l].rating > standings[r].rating;
+      });
+
+      // Pair neighbours on the ladder, preferring opponents not met yet; odd one out sits out
+      std::vector<std::pair<std::size_t, std::size_t>> pairs;
+      std::vector<bool> paired (order.size (), false);
+      for (std::size_t i = 0; i < order.size (); i++) {
+        if (paired[i])
+          continue;
+        std::size_t choice = order.size ();
+        for (std::size_t j = i + 1; j < order.size (); j++) {
+          if (paired[j])
+            continue;
+          if (choice == order.size ())
+            choice = j;
+          const auto key = std::minmax (order[i], order[j]);
+          if (played.count (key) == 0) {
+            choice = j;
+            break;
+          }
+        }
+        if (choice == order.size ())
+          break;
+        paired[i] = paired[choice] = true;
+        pairs.emplace_back (order[i], order[choice]);
+      }
+      return pairs;
+    }
+  } // namespace
+
+  TournamentReport runTournament (const TournamentConfig& config) {
+    std::vector<const PolicyInfo*> policies;
+    if (config.policies.empty ()) {
+      for (const auto& policy : builtinPolicies ()) {
+        policies.push_back (&policy);
+      }
+    } else {
+      for (const auto& name : config.policies) {
+        const PolicyInfo* policy = findPolicy (name);
+        if (policy == nullptr)
+          throw std::invalid_argument ("Unknown policy: " + name);
+        policies.push_back (policy);
+      }
+    }
+    if (policies.size () < 2)
+      throw std::invalid_argument ("A tournament needs at least two policies");
+
+    TournamentReport report;
+    report.threads = config.threads > 0 ? config.threads
+                                        : std::max (1u, std::thread::hardware_concurrency ());
+    report.standings.resize (policies.size ());
+    for (std::size_t i = 0; i < policies.size (); i++) {
+      report.standings[i].name = policies[i]->name;
+    }
+
+    std::vector<PolicyCost> costs (policies.size ());
+    SplitMix64 seeds (config.seed);
+    std::unique_ptr<Telemetry::TelemetryWriter> telemetry;
+    if (!config.telemetryPath.empty ()) {
+      telemetry = std::make_unique<Telemetry::TelemetryWriter> ();
+      if (!telemetry->open (config.telemetryPath))
+        telemetry.reset ();
+    }
+    std::set<std::pair<std::size_t, std::size_t>> played;
+
+    auto applyResults
+        = [&] (const std::vector<Pairing>& pairings, const std::vector<MatchResult>& results) {
+            for (std::size_t i = 0; i < pairings.size (); i++) {
+              Standing& a = report.standings[pairings[i].a];
+              Standing& b = report.standings[pairings[i].b];
+              const double score = matchScore (results[i]);
+              const double expected = 1.0 / (1.0 + std::pow (10.0, (b.rating - a.rating) / 400.0));
+              a.rating += config.eloK * (score - expected);
+              b.rating -= config.eloK * (score - expected);
+              if (score == 1.0) {
+                a.wins++;
+                b.losses++;
+              } else if (score == 0.0) {
+                a.losses++;
+                b.wins++;
+              } else {
+                a.draws++;
+                b.draws++;
+              }
+              report.ticks += results[i].a.ticks + results[i].b.ticks;
+              report.matches++;
+            }
+          };
+
+    const auto start = Clock::now ();
+    if (config.format == TournamentConfig::Format::RoundRobin) {
+      // Pairings do not depend on ratings, so every cycle runs in one parallel batch
+      std::vector<Pairing> pairings;
+      for (int round = 0; round < config.rounds; round++) {
+        for (std::size_t a = 0; a < policies.size (); a++) {
+          for (std::size_t b = a + 1; b < policies.size (); b++) {
+            pairings.push_back (Pairing{ a, b, seeds.next () });
+          }
+        }
+      }
+      applyResults (pairings, playMatches (pairings, policies, config, report.threads, costs,
+                                           telemetry.get (), 0));
+    } else {
+      for (int round = 0; round < config.rounds; round++) {
+        std::vector<Pairing> pairings;
+        for (const auto& pair : swissPairings (report.standings, played)) {
+          pairings.push_back (Pairing{ pair.first, pair.second, seeds.next () });
+          played.insert (std::minmax (pair.first, pair.second));
+        }
+        applyResults (pairings, playMatches (pairings, policies, config, report.threads, costs,
+                                             telemetry.get (), 2 * report.matches));
+      }
+    }
+    if (telemetry) {
+      telemetry->close ();
+      report.telemetryEvents = telemetry->stats ().rows;
+      report.telemetryBytes = telemetry->stats ().bytes;
+    }
+    report.seconds = std::chrono::duration<double> (Clock::now () - start).count ();
+
+    const double overhead = timerOverheadNanoseconds ();
+    for (std::size_t i = 0; i < policies.size (); i++) {
+      Standing& standing = report.standings[i];
+      standing.decisions = costs[i].decisions;
+      standing.sampledDecisions = costs[i].sampled;
+      const double net = static_cast<double> (costs[i].nanoseconds) - overhead * costs[i].sampled;
+      standing.sampledNanoseconds = net > 0.0 ? static_cast<std::uint64_t> (net) : 0;
+    }
+    std::stable_sort (report.standings.begin (), report.standings.end (),
+                      [] (const Standing& l, const Standing& r) { return l.rating > r.rating; });
+    return report;
+  }
+
+  std::string formatReport (const TournamentReport& report) {
+    std::string text = fmt::format ("{:>4}  {:<12} {:>7}  {:>6} {:>6} {:>6}  {:>12}\n", "rank",
+                                    "policy", "elo", "won", "drawn", "lost", "ns/decision");
+    int rank = 1;
+    for (const auto& standing : report.standings) {
+      const double perDecision
+          = standing.sampledDecisions > 0
+                ? static_cast<double> (standing.sampledNanoseconds) / standing.sampledDecisions
+                : 0.0;
+      text += fmt::format ("{:>4}  {:<12} {:>7.1f}  {:>6} {:>6} {:>6}  {:>12.1f}\n", rank++,
+                           standing.name, standing.rating, standing.wins, standing.draws,
+                           standing.losses, perDecision);
+    }
+    const double seconds = report.seconds > 0.0 ? report.seconds : 1e-9;
+    text += fmt::format ("{} matches, {} ticks in {:.2f} s on {} threads: {:.1f} matches/s, "
+                         "{:.3g} ticks/s",
+                         report.matches, report.ticks, report.seconds, report.threads,
+                         report.matches / seconds, report.ticks / seconds);
+    if (report.telemetryEvents > 0) {
+      text += fmt::format ("\n{} telemetry events in {} bytes ({:.2f} bytes/event)",
+                           report.telemetryEvents, report.telemetryBytes,
+                           static_cast<double> (report.telemetryBytes) / report.telemetryEvents);
+    }
+    return text;
+  }
+
+} // namespace Tournament
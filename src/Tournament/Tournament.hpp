@@ -0,0 +1,69 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Headless round robin / Swiss tournament between paddle policies with an Elo ladder
+
+#ifndef TOURNAMENT_HPP
+#define TOURNAMENT_HPP
+
+#include "Policies.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Tournament {
+
+  // A match is played in duplicate: both policies play a full game on the same seed (same
+  // serve angles) and the higher score wins, lives left break ties.
+  // Timing every decision would put two clock reads around a call that costs about as
+  // much, inflating the cost reported and slowing the games measured
+  constexpr std::uint64_t decisionSampleInterval = 64;
+
+  struct TournamentConfig {
+    enum class Format { RoundRobin, Swiss };
+
+    std::vector<std::string> policies; // empty selects every builtin policy
+    Format format = Format::RoundRobin;
+    int rounds = 100;                  // round robin cycles or Swiss rounds
+    unsigned int threads = 0;          // 0 uses every hardware thread
+    std::uint64_t seed = 1;
+    std::uint64_t maxTicks = 36000;    // per game, 5 minutes at 120 ticks per second
+    double eloK = 24.0;
+    // The classic and arcade rule sets play with their rules compiled in; any other rules
+    // at runtime, so rule set sweeps need no rebuild
+    dotname::Rules rules;
+    // Columnar event file of every game (see Telemetry::TelemetryWriter); empty disables it.
+    // Games are numbered in pairing order, side a before side b.
+    std::filesystem::path telemetryPath;
+  };
+
+  struct Standing {
+    std::string name;
+    double rating = 1500.0;
+    int wins = 0;
+    int draws = 0;
+    int losses = 0;
+    std::uint64_t decisions = 0;
+    // Every decisionSampleInterval-th decision is timed, less the cost of reading the clock
+    std::uint64_t sampledDecisions = 0;
+    std::uint64_t sampledNanoseconds = 0;
+  };
+
+  struct TournamentReport {
+    std::vector<Standing> standings; // sorted by rating, best first
+    std::uint64_t matches = 0;
+    std::uint64_t ticks = 0;
+    std::uint64_t telemetryEvents = 0;
+    std::uint64_t telemetryBytes = 0;
+    unsigned int threads = 0;
+    double seconds = 0.0;
+  };
+
+  // Throws std::invalid_argument for unknown policy names or fewer than two policies
+  TournamentReport runTournament (const TournamentConfig& config);
+  std::string formatReport (const TournamentReport& report);
+
+} // namespace Tournament
+
+#endif // TOURNAMENT_HPP
@@ -6,12 +6,19 @@
 
 #include "Logger/Logger.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 // fullfilled from ../cmake/tmplt-assets.cmake)
@@ -33,8 +40,15 @@
 #elif defined(__APPLE__)
   #include <limits.h>
   #include <mach-o/dyld.h>
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
 #else // Linux
   #include <limits.h>
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
   #include <unistd.h>
 #endif
 
@@ -42,13 +56,168 @@ namespace Utils {
 
   namespace FileIO {
     inline std::string readFile (const std::filesystem::path& filePath) {
-      std::ifstream file (filePath, std::ios::in);
+      std::ifstream file (filePath, std::ios::in | std::ios::binary);
       if (!file.is_open ()) {
         throw std::ios_base::failure ("Failed to open file: " + filePath.string ());
       }
-      std::stringstream buffer;
-      buffer << file.rdbuf ();
-      return buffer.str ();
+      // Read straight into the result instead of going through a stringstream copy
+      std::string content (static_cast<std::size_t> (std::filesystem::file_size (filePath)), '\0');
+      file.read (content.data (), static_cast<std::streamsize> (content.size ()));
+      content.resize (static_cast<std::size_t> (file.gcount ()));
+      return content;
+    }
+
+    // Read-only view of a whole file. The file is memory mapped when the platform allows it,
+    // otherwise it is streamed once into an owned buffer; either way view() stays valid for
+    // the lifetime of the object and the contents can be parsed in place.
+    class MappedFile {
+    public:
+      MappedFile () = default;
+      explicit MappedFile (const std::filesystem::path& filePath) {
+        open (filePath);
+      }
+      ~MappedFile () {
+        close ();
+      }
+      MappedFile (const MappedFile&) = delete;
+      MappedFile& operator= (const MappedFile&) = delete;
+      MappedFile (MappedFile&& other) noexcept {
+        *this = std::move (other);
+      }
+      MappedFile& operator= (MappedFile&& other) noexcept {
+        if (this != &other) {
+          close ();
+          data_ = std::exchange (other.data_, nullptr);
+          size_ = std::exchange (other.size_, 0);
+          mapped_ = std::exchange (other.mapped_, false);
+          fallback_ = std::move (other.fallback_);
+          if (!mapped_ && !fallback_.empty ()) {
+            data_ = fallback_.data (); // small buffers do not survive a move in place
+          }
+#ifdef _WIN32
+          mapping_ = std::exchange (other.mapping_, nullptr);
+#endif
+        }
+        return *this;
+      }
+
+      void open (const std::filesystem::path& filePath) {
+        close ();
+        size_ = static_cast<std::size_t> (std::filesystem::file_size (filePath));
+        if (size_ == 0) {
+          return;
+        }
+        if (!map (filePath)) {
+          fallback_ = readFile (filePath);
+          data_ = fallback_.data ();
+          size_ = fallback_.size ();
+        }
+      }
+
+      void close () {
+        if (mapped_) {
+#ifdef _WIN32
+          UnmapViewOfFile (data_);
+          CloseHandle (mapping_);
+          mapping_ = nullptr;
+#else
+          munmap (const_cast<char*> (data_), size_);
+#endif
+        }
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+        fallback_.clear ();
+        fallback_.shrink_to_fit ();
+      }
+
+      const char* data () const {
+        return data_;
+      }
+      std::size_t size () const {
+        return size_;
+      }
+      bool empty () const {
+        return size_ == 0;
+      }
+      bool isMapped () const {
+        return mapped_;
+      }
+      std::string_view view () const {
+        return std::string_view (data_, size_);
+      }
+      const unsigned char* bytes () const {
+        return reinterpret_cast<const unsigned char*> (data_);
+      }
+
+    private:
+      bool map (const std::filesystem::path& filePath) {
+#ifdef _WIN32
+        HANDLE file = CreateFileW (filePath.wstring ().c_str (), GENERIC_READ, FILE_SHARE_READ,
+                                   nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+          return false;
+        }
+        mapping_ = CreateFileMappingW (file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle (file);
+        if (mapping_ == nullptr) {
+          return false;
+        }
+        data_ = static_cast<const char*> (MapViewOfFile (mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_ == nullptr) {
+          CloseHandle (mapping_);
+          mapping_ = nullptr;
+          return false;
+        }
+#else
+        const int fd = ::open (filePath.c_str (), O_RDONLY);
+        if (fd < 0) {
+          return false;
+        }
+        void* address = mmap (nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close (fd);
+        if (address == MAP_FAILED) {
+          return false;
+        }
+        data_ = static_cast<const char*> (address);
+#endif
+        mapped_ = true;
+        return true;
+      }
+
+      const char* data_ = nullptr;
+      std::size_t size_ = 0;
+      bool mapped_ = false;
+      std::string fallback_;
+#ifdef _WIN32
+      HANDLE mapping_ = nullptr;
+#endif
+    };
+
+    // Streams a file in fixed size chunks on a worker thread. onChunk receives each chunk
+    // and its offset; the view is only valid during the call. The future yields the total
+    // number of bytes read or rethrows the I/O error.
+    inline std::future<std::uintmax_t>
+    readChunksAsync (const std::filesystem::path& filePath, std::size_t chunkSize,
+                     std::function<void (std::string_view chunk, std::uintmax_t offset)> onChunk) {
+      return std::async (std::launch::async, [filePath, chunkSize, onChunk = std::move (onChunk)] {
+        std::ifstream file (filePath, std::ios::in | std::ios::binary);
+        if (!file.is_open ()) {
+          throw std::ios_base::failure ("Failed to open file: " + filePath.string ());
+        }
+        std::vector<char> buffer (chunkSize > 0 ? chunkSize : 64 * 1024);
+        std::uintmax_t offset = 0;
+        while (file) {
+          file.read (buffer.data (), static_cast<std::streamsize> (buffer.size ()));
+          const auto count = static_cast<std::size_t> (file.gcount ());
+          if (count == 0) {
+            break;
+          }
+          onChunk (std::string_view (buffer.data (), count), offset);
+          offset += count;
+        }
+        return offset;
+      });
     }
 
     inline void writeFile (const std::filesystem::path& filePath, const std::string& content) {
@@ -97,6 +266,30 @@ namespace Utils {
       return path;
     }
 
+    // Per user cache directory for the application (not created here)
+    inline std::filesystem::path getCacheDirectory (const std::string& appName) {
+      std::filesystem::path base;
+#ifdef _WIN32
+      if (const char* localAppData = std::getenv ("LOCALAPPDATA")) {
+        base = localAppData;
+      }
+#elif defined(__APPLE__)
+      if (const char* home = std::getenv ("HOME")) {
+        base = std::filesystem::path (home) / "Library" / "Caches";
+      }
+#else
+      if (const char* xdgCache = std::getenv ("XDG_CACHE_HOME"); xdgCache && *xdgCache) {
+        base = xdgCache;
+      } else if (const char* home = std::getenv ("HOME")) {
+        base = std::filesystem::path (home) / ".cache";
+      }
+#endif
+      if (base.empty ()) {
+        base = std::filesystem::temp_directory_path ();
+      }
+      return base / appName;
+    }
+
   } // namespace PathUtils
 
   namespace FileManager {
@@ -120,6 +313,15 @@ namespace Utils {
       return files;
     }
   } // namespace FileManager
+
+  namespace Stats {
+    // Nearest rank percentile of sorted values, 0 when empty
+    inline double percentile (const std::vector<double>& sorted, double share) {
+      if (sorted.empty ())
+        return 0.0;
+      return sorted[static_cast<std::size_t> (share * (sorted.size () - 1) + 0.5)];
+    }
+  } // namespace Stats
 } // namespace Utils
 
 #endif // UTILS_HPP
\ No newline at end of file
@@ -1,13 +1,16 @@
 // MIT License
 // Copyright (c) 2024-2025 Tomáš Mark
 
+#include "Tools.hpp"
+
 #include "GameEngine/GameEngine.hpp"
+#include "GameEngine/EngineGroup.hpp"
+#include "Assets/AssetIndex.hpp"
 #include "Logger/Logger.hpp"
 #include "Utils/Utils.hpp"
 
 #include <cxxopts.hpp>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -28,7 +31,33 @@ namespace Config {
 
 std::unique_ptr<dotname::GameEngine> uniqueLib;
 
-int processArguments (int argc, const char* argv[]) {
+// Several matches side by side in one window, sharing the audio device and note bank.
+// Odd engines use the W/S keys; metrics, spectators, telemetry and the flight recorder cover
+// the first engine.
+int runEngines (int count, const dotname::EngineConfig& config) {
+  std::vector<std::unique_ptr<dotname::GameEngine>> engines;
+  dotname::EngineGroup group (config);
+  for (int i = 0; i < count; i++) {
+    dotname::EngineConfig engineConfig = config;
+    engineConfig.wasdKeys = i % 2 == 1;
+    if (i > 0) {
+      engineConfig.metricsEndpoint.clear ();
+      engineConfig.spectatorEndpoint.clear ();
+      engineConfig.telemetryPath.clear ();
+      engineConfig.flightRecorderPath.clear ();
+    }
+    engines.push_back (std::make_unique<dotname::GameEngine> ());
+    if (!engines.back ()->Init (Config::assetsPath, engineConfig))
+      return 1;
+    group.add (*engines.back ());
+  }
+  group.run ();
+  return 0;
+}
+
+// handled is set when --help or a tool mode (tournament, reports, spectating, several
+// engines) did all the work, and the single game's asset listing is skipped
+int processArguments (int argc, const char* argv[], bool& handled) {
   try {
     auto options = std::make_unique<cxxopts::Options> (argv[0], Config::standaloneName);
     options->positional_help ("[optional args]").show_positional_help ();
@@ -39,10 +68,76 @@ int processArguments (int argc, const char* argv[]) {
                              cxxopts::value<bool> ()->default_value ("false"));
     options->add_options () ("2,log2file", "Log to file",
                              cxxopts::value<bool> ()->default_value ("false"));
+    options->add_options () ("3,adpcm", "Keep audio samples IMA-ADPCM compressed in memory",
+                             cxxopts::value<bool> ()->default_value ("false"));
+    options->add_options () ("4,nocache", "Do not use the decoded asset cache",
+                             cxxopts::value<bool> ()->default_value ("false"));
+    options->add_options ("Diagnostics") (
+        "metrics", "Serve Prometheus metrics on a localhost port or unix:<path>",
+        cxxopts::value<std::string> ()->default_value (""));
+    options->add_options ("Diagnostics") (
+        "spectator", "Stream the game state to spectators on a localhost port or unix:<path>",
+        cxxopts::value<std::string> ()->default_value (""));
+    options->add_options ("Diagnostics") (
+        "spectate", "Follow a spectator stream and report its bytes/tick and latency",
+        cxxopts::value<std::string> ());
+    options->add_options ("Diagnostics") (
+        "telemetry", "Record gameplay events of the game or tournament to a columnar file",
+        cxxopts::value<std::string> ()->default_value (""));
+    options->add_options ("Diagnostics") (
+        "telemetry-report", "Summarize rallies, paddle hits and lost balls of a telemetry file",
+        cxxopts::value<std::string> ());
+    options->add_options ("Diagnostics") (
+        "flight-recorder", "Keep the last seconds of play in a file that survives a crash",
+        cxxopts::value<std::string> ()->default_value (""));
+    options->add_options ("Diagnostics") ("flight-seconds", "Seconds the flight recorder keeps",
+                                          cxxopts::value<double> ()->default_value ("30"));
+    options->add_options ("Diagnostics") (
+        "flight-decode", "Summarize a flight recorder file and replay it headless",
+        cxxopts::value<std::string> ());
+    options->add_options ("Diagnostics") (
+        "draw-stress", "Draw N extra animated shapes to load the batched renderer",
+        cxxopts::value<int> ()->default_value ("0"));
+    options->add_options ("Diagnostics") ("alloc-report", "Log heap allocations per frame",
+                                          cxxopts::value<bool> ()->default_value ("false"));
+    options->add_options () ("fps", "Frame rate cap",
+                             cxxopts::value<int> ()->default_value ("120"));
+    options->add_options () ("power-budget",
+                             "Share of one core the frame work may use, lowers the frame rate",
+                             cxxopts::value<double> ()->default_value ("1.0"));
+    options->add_options () ("no-idle", "Keep redrawing paused and game over screens",
+                             cxxopts::value<bool> ()->default_value ("false"));
+    options->add_options () ("render-scale",
+                             "Internal resolution as a share of the window (0 = automatic)",
+                             cxxopts::value<float> ()->default_value ("0"));
+    options->add_options () ("min-render-scale", "Lowest automatic render scale",
+                             cxxopts::value<float> ()->default_value ("0.5"));
+    options->add_options () ("engines", "Independent matches side by side in one window",
+                             cxxopts::value<int> ()->default_value ("1"));
+    options->add_options ("Tournament") ("tournament", "Run a headless bot tournament and exit",
+                                         cxxopts::value<bool> ()->default_value ("false"));
+    options->add_options ("Tournament") (
+        "policies", "Comma separated policies (default all)",
+        cxxopts::value<std::vector<std::string>> ()->default_value (""));
+    options->add_options ("Tournament") (
+        "format", "roundrobin or swiss",
+        cxxopts::value<std::string> ()->default_value ("roundrobin"));
+    options->add_options ("Tournament") ("rounds", "Round robin cycles or Swiss rounds",
+                                         cxxopts::value<int> ()->default_value ("100"));
+    options->add_options ("Tournament") ("threads", "Worker threads (0 = all cores)",
+                                         cxxopts::value<unsigned int> ()->default_value ("0"));
+    options->add_options ("Tournament") ("seed", "Tournament seed",
+                                         cxxopts::value<std::uint64_t> ()->default_value ("1"));
+    options->add_options ("Tournament") ("max-ticks", "Tick limit per game",
+                                         cxxopts::value<std::uint64_t> ()->default_value ("36000"));
+    options->add_options ("Tournament") (
+        "rules", "classic or arcade, then optional name=value overrides (classic,ballRadius=5)",
+        cxxopts::value<std::string> ()->default_value ("classic"));
     const auto result = options->parse (argc, argv);
 
     if (result.count ("help")) {
-      LOG_I_STREAM << options->help ({ "", "Group" }) << std::endl;
+      LOG_I_STREAM << options->help ({ "", "Group", "Diagnostics", "Tournament" }) << std::endl;
+      handled = true;
       return 0;
     }
 
@@ -51,9 +146,46 @@ int processArguments (int argc, const char* argv[]) {
       LOG_D_STREAM << "Logging to file enabled [-2]" << std::endl;
     }
 
+    handled = true;
+    if (result["tournament"].as<bool> ()) {
+      return runTournament (result);
+    }
+    if (result.count ("telemetry-report")) {
+      return runTelemetryReport (result["telemetry-report"].as<std::string> ());
+    }
+    if (result.count ("flight-decode")) {
+      return runFlightDecode (result["flight-decode"].as<std::string> ());
+    }
+    if (result.count ("spectate")) {
+      return runSpectator (result["spectate"].as<std::string> ());
+    }
+    handled = false;
+
+    dotname::EngineConfig engineConfig;
+    engineConfig.compressedSamples = result["adpcm"].as<bool> ();
+    engineConfig.reportAllocations = result["alloc-report"].as<bool> ();
+    engineConfig.metricsEndpoint = result["metrics"].as<std::string> ();
+    engineConfig.spectatorEndpoint = result["spectator"].as<std::string> ();
+    engineConfig.telemetryPath = result["telemetry"].as<std::string> ();
+    engineConfig.flightRecorderPath = result["flight-recorder"].as<std::string> ();
+    engineConfig.flightRecorderSeconds = result["flight-seconds"].as<double> ();
+    engineConfig.stressEntities = result["draw-stress"].as<int> ();
+    engineConfig.targetFps = result["fps"].as<int> ();
+    engineConfig.powerBudget = result["power-budget"].as<double> ();
+    engineConfig.idleThrottle = !result["no-idle"].as<bool> ();
+    engineConfig.renderScale = result["render-scale"].as<float> ();
+    engineConfig.minRenderScale = result["min-render-scale"].as<float> ();
+    if (!result["nocache"].as<bool> ()) {
+      engineConfig.cacheDirectory = PathUtils::getCacheDirectory (Config::standaloneName);
+    }
+
+    if (!result.count ("omit") && result["engines"].as<int> () > 1) {
+      handled = true;
+      return runEngines (result["engines"].as<int> (), engineConfig);
+    }
     if (!result.count ("omit")) {
       // uniqueLib = std::make_unique<dotname::GameEngine> ();
-      uniqueLib = std::make_unique<dotname::GameEngine> (Config::assetsPath);
+      uniqueLib = std::make_unique<dotname::GameEngine> (Config::assetsPath, engineConfig);
     } else {
       LOG_D_STREAM << "Loading library omitted [-1]" << std::endl;
     }
@@ -75,6 +207,15 @@ int processArguments (int argc, const char* argv[]) {
 
 int printAssets (const std::filesystem::path& assetsPath) {
   try {
+    // The build time manifest avoids a directory scan
+    Assets::AssetIndex index;
+    if (index.load (assetsPath)) {
+      for (const auto& asset : index.entries ()) {
+        std::cout << "asset: " << asset.name << " (" << asset.size << " bytes)" << std::endl;
+      }
+      return 0;
+    }
+
     auto files = FileManager::listFiles (assetsPath);
     for (const auto& file : files) {
       std::cout << "asset: " << file << std::endl;
@@ -94,9 +235,13 @@ int main (int argc, const char* argv[]) {
 
   LOG_I_STREAM << "Starting " << Config::standaloneName << " ..." << std::endl;
 
-  if (processArguments (argc, argv) != 0) {
+  bool handled = false;
+  if (processArguments (argc, argv, handled) != 0) {
     return 1;
   }
+  if (handled) {
+    return 0;
+  }
   if (printAssets (Config::assetsPath) != 0) {
     return 1;
   }
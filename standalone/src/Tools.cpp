@@ -0,0 +1,329 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Tools of the game executable for the files and streams a game produces
+
+#include "Tools.hpp"
+
+#include "GameEngine/Simulation.hpp"
+#include "FlightRecorder/FlightRecorder.hpp"
+#include "Spectator/SpectatorServer.hpp"
+#include "Telemetry/Telemetry.hpp"
+#include "Tournament/Tournament.hpp"
+#include "Logger/Logger.hpp"
+#include "Utils/Utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+using namespace Utils;
+
+namespace {
+
+  std::uint64_t nowUs () {
+    return static_cast<std::uint64_t> (std::chrono::duration_cast<std::chrono::microseconds> (
+                                           std::chrono::steady_clock::now ().time_since_epoch ())
+                                           .count ());
+  }
+
+  // "classic" or "arcade", optionally followed by field=value overrides, for example
+  // "classic,ballRadius=5,launchSpeed=8"
+  bool parseRules (const std::string& text, dotname::Rules& rules) {
+    static const std::pair<const char*, int dotname::Rules::*> fields[] = {
+      { "courtWidth", &dotname::Rules::courtWidth },
+      { "courtHeight", &dotname::Rules::courtHeight },
+      { "maxLife", &dotname::Rules::maxLife },
+      { "paddleX", &dotname::Rules::paddleX },
+      { "paddleWidth", &dotname::Rules::paddleWidth },
+      { "paddleHeight", &dotname::Rules::paddleHeight },
+      { "paddleSpeed", &dotname::Rules::paddleSpeed },
+      { "launchSpeed", &dotname::Rules::launchSpeed },
+      { "deflection", &dotname::Rules::deflection },
+      { "ballRadius", &dotname::Rules::ballRadius },
+    };
+    std::stringstream stream (text);
+    std::string item;
+    bool first = true;
+    while (std::getline (stream, item, ',')) {
+      const auto equals = item.find ('=');
+      if (first && equals == std::string::npos) {
+        first = false;
+        if (item == "classic") {
+          rules = dotname::ClassicRuleSet::value;
+          continue;
+        }
+        if (item == "arcade") {
+          rules = dotname::ArcadeRuleSet::value;
+          continue;
+        }
+        LOG_E_STREAM << "Unknown rule set: " << item << std::endl;
+        return false;
+      }
+      first = false;
+      const std::string name = item.substr (0, equals);
+      auto field = std::find_if (std::begin (fields), std::end (fields),
+                                 [&] (const auto& entry) { return name == entry.first; });
+      if (equals == std::string::npos || field == std::end (fields)) {
+        LOG_E_STREAM << "Unknown rule: " << item << std::endl;
+        return false;
+      }
+      try {
+        rules.*(field->second) = std::stoi (item.substr (equals + 1));
+      } catch (const std::exception&) {
+        LOG_E_STREAM << "Invalid rule value: " << item << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+} // namespace
+
+int runTournament (const cxxopts::ParseResult& result) {
+  Tournament::TournamentConfig config;
+  for (const auto& name : result["policies"].as<std::vector<std::string>> ()) {
+    if (!name.empty ()) {
+      config.policies.push_back (name);
+    }
+  }
+  const auto format = result["format"].as<std::string> ();
+  if (format == "swiss") {
+    config.format = Tournament::TournamentConfig::Format::Swiss;
+  } else if (format != "roundrobin") {
+    LOG_E_STREAM << "Unknown tournament format: " << format << std::endl;
+    return 1;
+  }
+  config.rounds = result["rounds"].as<int> ();
+  config.threads = result["threads"].as<unsigned int> ();
+  config.seed = result["seed"].as<std::uint64_t> ();
+  config.maxTicks = result["max-ticks"].as<std::uint64_t> ();
+  config.telemetryPath = result["telemetry"].as<std::string> ();
+  if (!parseRules (result["rules"].as<std::string> (), config.rules)) {
+    return 1;
+  }
+
+  try {
+    const auto report = Tournament::runTournament (config);
+    std::cout << Tournament::formatReport (report) << std::endl;
+  } catch (const std::invalid_argument& e) {
+    LOG_E_STREAM << e.what () << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+// Rally length, paddle hit positions and time between lost balls from a telemetry file
+int runTelemetryReport (const std::filesystem::path& path) {
+  Telemetry::TelemetryReader reader;
+  if (!reader.open (path)) {
+    LOG_E_STREAM << "Not a telemetry file: " << path << std::endl;
+    return 1;
+  }
+  struct GameState {
+    int hits = 0;
+    std::uint32_t lastLoss = 0;
+  };
+  std::unordered_map<std::uint64_t, GameState> games;
+  std::vector<double> rallies;
+  std::vector<double> hitOffsets;
+  std::vector<double> lossIntervals;
+  std::uint64_t events = 0;
+  std::uint64_t gamesSeen = 0;
+  std::uint64_t gamesOver = 0;
+  std::uint64_t wallBounces = 0;
+
+  Telemetry::EventColumns columns;
+  while (reader.next (columns)) {
+    events += columns.rows;
+    for (std::size_t row = 0; row < columns.rows; row++) {
+      const auto inserted = games.try_emplace (columns.match[row]);
+      gamesSeen += inserted.second ? 1 : 0;
+      GameState& game = inserted.first->second;
+      switch (static_cast<dotname::GameEventType> (columns.type[row])) {
+      case dotname::GameEventType::WallBounce:
+        wallBounces++;
+        break;
+      case dotname::GameEventType::PaddleHit:
+        game.hits++;
+        hitOffsets.push_back (static_cast<double> (columns.paddleOffset[row])
+                              / Telemetry::subpixels);
+        break;
+      case dotname::GameEventType::BallLost:
+        rallies.push_back (game.hits);
+        lossIntervals.push_back (columns.tick[row] - game.lastLoss);
+        game.hits = 0;
+        game.lastLoss = columns.tick[row];
+        break;
+      case dotname::GameEventType::GameOver:
+        gamesOver++;
+        games.erase (inserted.first);
+        break;
+      }
+    }
+  }
+  if (reader.failed ())
+    LOG_W_STREAM << "Damaged chunk in " << path << ", the report covers the ones before it"
+                 << std::endl;
+
+  std::sort (rallies.begin (), rallies.end ());
+  std::sort (hitOffsets.begin (), hitOffsets.end ());
+  std::sort (lossIntervals.begin (), lossIntervals.end ());
+  auto mean = [] (const std::vector<double>& values) {
+    double sum = 0.0;
+    for (double value : values)
+      sum += value;
+    return values.empty () ? 0.0 : sum / values.size ();
+  };
+  LOG_I_FMT ("{} events of {} games ({} finished), {} wall bounces", events, gamesSeen,
+             gamesOver, wallBounces);
+  LOG_I_FMT ("Rally length in paddle hits: mean {:.2f}, p50 {:.0f}, p95 {:.0f}, max {:.0f}",
+             mean (rallies), Stats::percentile (rallies, 0.5),
+             Stats::percentile (rallies, 0.95), rallies.empty () ? 0.0 : rallies.back ());
+  LOG_I_FMT ("Paddle hit offset from centre in px: mean {:.2f}, p5 {:.2f}, p50 {:.2f}, "
+             "p95 {:.2f}",
+             mean (hitOffsets), Stats::percentile (hitOffsets, 0.05),
+             Stats::percentile (hitOffsets, 0.5), Stats::percentile (hitOffsets, 0.95));
+  LOG_I_FMT ("Ticks between lost balls: mean {:.0f}, p50 {:.0f}, p95 {:.0f} ({:.1f} s mean at "
+             "{} ticks/s)",
+             mean (lossIntervals), Stats::percentile (lossIntervals, 0.5),
+             Stats::percentile (lossIntervals, 0.95),
+             mean (lossIntervals) / dotname::ticksPerSecond, dotname::ticksPerSecond);
+  return reader.failed () ? 1 : 0;
+}
+
+// What a flight recorder file holds: how the run ended, the last frames and log lines, and
+// a headless replay of the recorded inputs checked against the recorded snapshots
+int runFlightDecode (const std::filesystem::path& path) {
+  FlightRecorder::FlightLog log;
+  if (!FlightRecorder::read (path, log))
+    return 1;
+
+  std::string ending = "still running, or killed without a catchable signal";
+  if (log.state == FlightRecorder::RunState::Stopped)
+    ending = "stopped cleanly";
+  else if (log.state == FlightRecorder::RunState::Crashed)
+    ending = fmt::format ("crashed with signal or exception {}", log.signal);
+  else if (log.state == FlightRecorder::RunState::Interrupted)
+    ending = fmt::format ("interrupted by signal {} (SIGINT or SIGTERM)", log.signal);
+  LOG_I_FMT ("{}: {}; {} of {} slots kept ({} written, {} torn), {} log lines", path.string (),
+             ending, log.records.size (), log.slotCount, log.written, log.tornSlots,
+             log.logs.size ());
+
+  std::vector<double> intervals;
+  double update = 0.0;
+  double draw = 0.0;
+  std::uint64_t inputs = 0;
+  std::uint64_t snapshots = 0;
+  const FlightRecorder::Record* lastSnapshot = nullptr;
+  const FlightRecorder::Record* lastInput = nullptr;
+  for (const FlightRecorder::Record& record : log.records) {
+    switch (record.type) {
+    case FlightRecorder::RecordType::Frame: {
+      const auto frame = FlightRecorder::payloadAs<FlightRecorder::FrameRecord> (record);
+      intervals.push_back (frame.intervalMs);
+      update += frame.updateMs;
+      draw += frame.drawMs;
+      break;
+    }
+    case FlightRecorder::RecordType::Input:
+      inputs++;
+      lastInput = &record;
+      break;
+    case FlightRecorder::RecordType::Snapshot:
+      snapshots++;
+      lastSnapshot = &record;
+      break;
+    case FlightRecorder::RecordType::Marker: {
+      const auto marker = FlightRecorder::payloadAs<FlightRecorder::MarkerRecord> (record);
+      if (marker.marker == static_cast<std::uint8_t> (FlightRecorder::Marker::Signal))
+        LOG_I_FMT ("  {} ms: signal {}", record.timeMs, marker.signal);
+      else if (marker.marker == static_cast<std::uint8_t> (FlightRecorder::Marker::Interrupted))
+        LOG_I_FMT ("  {} ms: interrupted by signal {}", record.timeMs, marker.signal);
+      break;
+    }
+    default:
+      break;
+    }
+  }
+  if (!log.records.empty ())
+    LOG_I_FMT ("  {:.1f} s recorded: {} inputs, {} snapshots, {} frames",
+               (log.records.back ().timeMs - log.records.front ().timeMs) / 1000.0, inputs,
+               snapshots, intervals.size ());
+  if (!intervals.empty ()) {
+    const std::size_t frames = intervals.size ();
+    std::sort (intervals.begin (), intervals.end ());
+    LOG_I_FMT ("  Frames: interval p50 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms; update {:.3f} "
+               "ms, draw {:.3f} ms mean",
+               Stats::percentile (intervals, 0.5), Stats::percentile (intervals, 0.99),
+               intervals.back (), update / frames, draw / frames);
+  }
+  if (lastInput) {
+    const auto input = FlightRecorder::payloadAs<FlightRecorder::InputRecord> (*lastInput);
+    LOG_I_FMT ("  Last input at tick {}: up {:.2f}, down {:.2f}, launch {}, pause {}, "
+               "restart {}",
+               input.tick, input.up, input.down, input.launch, input.pause, input.restart);
+  }
+  if (lastSnapshot) {
+    const auto state = FlightRecorder::payloadAs<FlightRecorder::SnapshotRecord> (*lastSnapshot);
+    LOG_I_FMT ("  Last snapshot at tick {}: ball ({:.1f}, {:.1f}), paddle {:.1f}, score {}, "
+               "lives {}{}",
+               state.tick, state.ballX, state.ballY, state.paddleY, state.score, state.life,
+               state.gameOver ? ", game over" : "");
+  }
+  const std::size_t shownLines = std::min<std::size_t> (log.logs.size (), 10);
+  for (std::size_t i = log.logs.size () - shownLines; i < log.logs.size (); i++) {
+    const FlightRecorder::LogLine& line = log.logs[i];
+    LOG_I_FMT ("  {} ms [{}] {}", line.timeMs,
+               LOG.levelToString (static_cast<Logger::Level> (line.level)), line.text);
+  }
+
+  const FlightRecorder::ReplaySummary replay = FlightRecorder::replay (log);
+  LOG_I_FMT ("Replay: {} steps from {} snapshot restarts, {} snapshots checked, {} diverged "
+             "(first at tick {}); ends at tick {} with ball ({:.1f}, {:.1f}), score {}",
+             replay.steps, replay.resyncs, replay.checked, replay.diverged,
+             replay.firstDivergedTick, replay.last.tick, replay.last.ballX, replay.last.ballY,
+             replay.last.score);
+  return replay.diverged > 0 ? 1 : 0;
+}
+
+// Follows a running game's spectator stream and logs its size and latency every 600 frames
+int runSpectator (const std::string& endpoint) {
+  Spectator::SpectatorClient client;
+  if (!client.connect (endpoint)) {
+    LOG_E_STREAM << "Cannot connect to the spectator stream on " << endpoint << std::endl;
+    return 1;
+  }
+  Spectator::TickState state;
+  bool keyframe = false;
+  std::vector<double> latencies;
+  std::uint64_t windowBytes = 0;
+  auto report = [&] () {
+    if (latencies.empty ())
+      return;
+    std::sort (latencies.begin (), latencies.end ());
+    LOG_I_FMT ("Spectating tick {} (score {}, life {}): {:.2f} bytes/tick, latency p50 {:.0f} "
+               "us, p99 {:.0f} us",
+               state.tick, state.score, state.life,
+               static_cast<double> (client.bytesReceived () - windowBytes) / latencies.size (),
+               Stats::percentile (latencies, 0.5), Stats::percentile (latencies, 0.99));
+    latencies.clear ();
+    windowBytes = client.bytesReceived ();
+  };
+  while (client.connected ()) {
+    if (!client.next (state, keyframe, 1000))
+      continue;
+    latencies.push_back (static_cast<double> (nowUs () - state.timeUs));
+    if (latencies.size () == 600)
+      report ();
+  }
+  report ();
+  LOG_I_STREAM << "Spectator stream closed after " << client.bytesReceived () << " bytes"
+               << std::endl;
+  return 0;
+}
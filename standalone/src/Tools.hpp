@@ -0,0 +1,21 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Tools of the game executable for the files and streams a game produces
+
+#ifndef TOOLS_HPP
+#define TOOLS_HPP
+
+#include <cxxopts.hpp>
+#include <filesystem>
+#include <string>
+
+// Headless bot tournament configured by the Tournament options
+int runTournament (const cxxopts::ParseResult& result);
+// Summary of a --telemetry file
+int runTelemetryReport (const std::filesystem::path& path);
+// Summary and headless replay of a --flight-recorder file
+int runFlightDecode (const std::filesystem::path& path);
+// Follows the --spectator stream of a running game
+int runSpectator (const std::string& endpoint);
+
+#endif // TOOLS_HPP
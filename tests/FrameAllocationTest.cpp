@@ -0,0 +1,94 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Steady state frames of the engine do not touch the heap
+
+#include <GameEngine/EngineGroup.hpp>
+#include <GameEngine/GameEngine.hpp>
+#include <Memory/FrameArena.hpp>
+
+#include <RaylibStub.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+  // Follows the ball for the first 100 of every 400 ticks and then moves away from it, so
+  // there are paddle hits, wall bounces, lost balls, game overs and restarts
+  void steer (const dotname::GameEngine& engine) {
+    const auto& simulation = engine.simulation;
+    RaylibStub::releaseKeys ();
+    if (simulation.gameOver) {
+      RaylibStub::pressKey (KEY_ENTER);
+      return;
+    }
+    if (!simulation.ball.active)
+      RaylibStub::pressKey (KEY_SPACE);
+    const float gap = simulation.ball.position.y - simulation.player.position.y;
+    if (simulation.tick % 400 < 100) {
+      RaylibStub::setKeyDown (KEY_UP, gap < -4.0f);
+      RaylibStub::setKeyDown (KEY_DOWN, gap > 4.0f);
+    } else {
+      // A ball served straight comes back level with the paddle, so there is no gap to widen
+      RaylibStub::setKeyDown (KEY_UP, gap >= 0.0f);
+      RaylibStub::setKeyDown (KEY_DOWN, gap < 0.0f);
+    }
+  }
+
+} // namespace
+
+// The frame path of the window loop (EngineGroup::tick: input, simulation, effects, timeline,
+// drawing, metrics, telemetry, flight recorder and spectator stream), after a game has been
+// played through once so pools and buffers have grown to their working size
+TEST (FrameAllocations, SteadyStateFramesDoNotAllocate) {
+  if (!Memory::trackingEnabled ())
+    GTEST_SKIP () << "needs the library built with ENABLE_ALLOCATION_TRACKING";
+
+  const std::filesystem::path temp = ::testing::TempDir ();
+  dotname::EngineConfig config;
+  config.targetFps = 2000; // paced by the stub's EndDrawing (), as raylib would
+  config.telemetryPath = temp / "frame-allocations.pongtel";
+  config.flightRecorderPath = temp / "frame-allocations.flight";
+#ifndef _WIN32
+  config.metricsEndpoint = "unix:" + (temp / "frame-allocations-metrics.sock").string ();
+  config.spectatorEndpoint = "unix:" + (temp / "frame-allocations-spectator.sock").string ();
+#endif
+
+  dotname::GameEngine engine;
+  ASSERT_TRUE (engine.Init (GAMEENGINE_TEST_ASSETS, config));
+  dotname::EngineGroup group (config);
+  group.add (engine);
+
+  std::uint64_t frame = 0;
+  int gamesOver = 0;
+  bool wasOver = false;
+  auto tick = [&] () {
+    steer (engine);
+    frame++;
+    ASSERT_TRUE (group.tick ());
+    if (engine.simulation.gameOver && !wasOver)
+      gamesOver++;
+    wasOver = engine.simulation.gameOver;
+  };
+
+  while (gamesOver < 1 || frame < 2000) {
+    ASSERT_NO_FATAL_FAILURE (tick ());
+    ASSERT_LT (frame, 60000u) << "warm up never finished a game";
+  }
+
+  const int warmUpGames = gamesOver;
+  const std::uint64_t soundsBefore = RaylibStub::soundsPlayed ();
+  // The game runs at its own tick rate, so a game takes a number of seconds rather than frames
+  const std::uint64_t measured = frame + 4000;
+  while (frame < measured || gamesOver == warmUpGames) {
+    ASSERT_NO_FATAL_FAILURE (tick ());
+    ASSERT_EQ (engine.GetFrameAllocations (), 0u) << "heap allocations in frame " << frame;
+    ASSERT_LT (frame, measured + 60000) << "the measured frames should end a game";
+  }
+  EXPECT_GT (RaylibStub::soundsPlayed (), soundsBefore);
+
+  engine.Shutdown ();
+}
@@ -0,0 +1,66 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// The metrics exporter survives scrapers that hang up before the response
+
+#include <Metrics/Metrics.hpp>
+#include <Net/Socket.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+  constexpr char scrape[] = "GET /metrics HTTP/1.0\r\n\r\n";
+
+  // The whole response to one scrape, read until the server closes the connection
+  std::string fetch (const std::string& endpoint) {
+    const Net::Handle client = Net::connect (endpoint);
+    if (client == Net::invalidHandle)
+      return {};
+    std::string response;
+    if (Net::send (client, scrape, std::strlen (scrape)) > 0) {
+      char buffer[4096];
+      while (Net::pollReadable (client, 2000) > 0) {
+        const long count = Net::receive (client, buffer, sizeof (buffer));
+        if (count <= 0)
+          break;
+        response.append (buffer, static_cast<std::size_t> (count));
+      }
+    }
+    Net::close (client);
+    return response;
+  }
+
+} // namespace
+
+// Writing to a socket whose peer has gone raises SIGPIPE on POSIX, which ends the process
+// unless every send opts out of it. A scraper closing right after its request makes the
+// response hit exactly that.
+TEST (MetricsServer, ScraperHangingUpDoesNotKillTheProcess) {
+#ifdef _WIN32
+  GTEST_SKIP () << "Winsock has no SIGPIPE";
+#else
+  const std::string endpoint
+      = "unix:" + (std::filesystem::path (::testing::TempDir ()) / "metrics-hangup.sock").string ();
+  Metrics::EngineMetrics metrics;
+  metrics.frames.add ();
+  Metrics::MetricsServer server (metrics);
+  ASSERT_TRUE (server.start (endpoint));
+
+  for (int i = 0; i < 32; i++) {
+    const Net::Handle client = Net::connect (endpoint);
+    ASSERT_NE (client, Net::invalidHandle);
+    ASSERT_GT (Net::send (client, scrape, std::strlen (scrape)), 0);
+    Net::close (client);
+  }
+
+  // Still here and still serving
+  const std::string response = fetch (endpoint);
+  EXPECT_EQ (response.rfind ("HTTP/1.0 200 OK\r\n", 0), 0u) << response;
+  EXPECT_NE (response.find ("pong_frames_total 1"), std::string::npos) << response;
+  server.stop ();
+#endif
+}
@@ -0,0 +1,266 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// raylib without window, GPU or audio device, linked into the tests in place of the real one
+
+#include "RaylibStub.hpp"
+
+#include <raylib.h>
+#include <rlgl.h>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+// Defined in the test executable itself, so the linker takes these over the raylib library the
+// engine links and never pulls a raylib object in. An engine change calling a raylib function
+// missing here fails to link with duplicate symbols: add the function below.
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  constexpr int keyCount = 512;
+  std::array<bool, keyCount> keysDown{};
+  std::array<int, 16> pressedKeys{};
+  std::size_t pressedHead = 0;
+  std::size_t pressedCount = 0;
+
+  int screenWidth = 0;
+  int screenHeight = 0;
+  bool audioReady = false;
+  unsigned int nextTextureId = 1;
+  Clock::duration targetFrame{};
+  Clock::time_point lastFrameEnd{};
+  const Clock::time_point started = Clock::now ();
+  std::uint64_t frames = 0;
+  std::uint64_t sounds = 0;
+
+  // Silent 16 bit mono samples of the given length
+  Wave silentWave (unsigned int frameCount, unsigned int sampleRate, unsigned int sampleSize,
+                   unsigned int channels) {
+    Wave wave{};
+    wave.frameCount = frameCount;
+    wave.sampleRate = sampleRate;
+    wave.sampleSize = sampleSize;
+    wave.channels = channels;
+    wave.data = std::calloc (static_cast<std::size_t> (frameCount) * channels, sampleSize / 8);
+    return wave;
+  }
+} // namespace
+
+namespace RaylibStub {
+
+  void setKeyDown (int key, bool down) {
+    if (key >= 0 && key < keyCount)
+      keysDown[static_cast<std::size_t> (key)] = down;
+  }
+
+  void pressKey (int key) {
+    if (pressedCount == pressedKeys.size ())
+      return;
+    pressedKeys[(pressedHead + pressedCount++) % pressedKeys.size ()] = key;
+  }
+
+  void releaseKeys () {
+    keysDown.fill (false);
+    pressedCount = 0;
+  }
+
+  std::uint64_t framesDrawn () {
+    return frames;
+  }
+
+  std::uint64_t soundsPlayed () {
+    return sounds;
+  }
+
+} // namespace RaylibStub
+
+extern "C" {
+
+// Window and timing
+void InitWindow (int width, int height, const char*) {
+  screenWidth = width;
+  screenHeight = height;
+}
+void CloseWindow (void) {
+}
+bool WindowShouldClose (void) {
+  return false;
+}
+void SetConfigFlags (unsigned int) {
+}
+void SetWindowPosition (int, int) {
+}
+void SetWindowSize (int width, int height) {
+  screenWidth = width;
+  screenHeight = height;
+}
+Vector2 GetMonitorPosition (int) {
+  return Vector2{ 0.0f, 0.0f };
+}
+int GetMonitorWidth (int) {
+  return 1920;
+}
+int GetMonitorHeight (int) {
+  return 1080;
+}
+int GetScreenWidth (void) {
+  return screenWidth;
+}
+int GetScreenHeight (void) {
+  return screenHeight;
+}
+void SetTargetFPS (int fps) {
+  targetFrame = fps > 0 ? std::chrono::duration_cast<Clock::duration> (
+                              std::chrono::duration<double> (1.0 / fps))
+                        : Clock::duration{};
+}
+int GetFPS (void) {
+  return targetFrame > Clock::duration{}
+             ? static_cast<int> (std::chrono::seconds (1) / targetFrame)
+             : 0;
+}
+double GetTime (void) {
+  return std::chrono::duration<double> (Clock::now () - started).count ();
+}
+void EnableEventWaiting (void) {
+}
+void DisableEventWaiting (void) {
+}
+
+// Keyboard, scripted through RaylibStub
+int GetKeyPressed (void) {
+  if (pressedCount == 0)
+    return 0;
+  const int key = pressedKeys[pressedHead];
+  pressedHead = (pressedHead + 1) % pressedKeys.size ();
+  pressedCount--;
+  return key;
+}
+bool IsKeyDown (int key) {
+  return key >= 0 && key < keyCount && keysDown[static_cast<std::size_t> (key)];
+}
+
+// Drawing
+void BeginDrawing (void) {
+}
+void EndDrawing (void) {
+  // raylib waits here for the frame rate set with SetTargetFPS ()
+  if (targetFrame > Clock::duration{} && lastFrameEnd != Clock::time_point{})
+    std::this_thread::sleep_until (lastFrameEnd + targetFrame);
+  lastFrameEnd = Clock::now ();
+  frames++;
+}
+void ClearBackground (Color) {
+}
+void BeginMode2D (Camera2D) {
+}
+void EndMode2D (void) {
+}
+void BeginTextureMode (RenderTexture2D) {
+}
+void EndTextureMode (void) {
+}
+RenderTexture2D LoadRenderTexture (int width, int height) {
+  RenderTexture2D target{};
+  target.id = nextTextureId++;
+  target.texture = Texture2D{ nextTextureId++, width, height, 1, 7 };
+  target.depth = Texture2D{ nextTextureId++, width, height, 1, 19 };
+  return target;
+}
+void UnloadRenderTexture (RenderTexture2D) {
+}
+void SetTextureFilter (Texture2D, int) {
+}
+void DrawTexturePro (Texture2D, Rectangle, Rectangle, Vector2, float, Color) {
+}
+Texture2D GetShapesTexture (void) {
+  return Texture2D{ 1, 1, 1, 1, 7 };
+}
+Rectangle GetShapesTextureRectangle (void) {
+  return Rectangle{ 0.0f, 0.0f, 1.0f, 1.0f };
+}
+void DrawText (const char*, int, int, int, Color) {
+}
+int MeasureText (const char* text, int fontSize) {
+  return static_cast<int> (std::strlen (text)) * fontSize / 2;
+}
+
+// rlgl batch, as used by Render::DrawList
+void rlBegin (int) {
+}
+void rlEnd (void) {
+}
+void rlSetTexture (unsigned int) {
+}
+void rlColor4ub (unsigned char, unsigned char, unsigned char, unsigned char) {
+}
+void rlTexCoord2f (float, float) {
+}
+void rlVertex2f (float, float) {
+}
+void rlNormal3f (float, float, float) {
+}
+bool rlCheckRenderBatchLimit (int) {
+  return false;
+}
+
+// Audio: every file decodes to 50 ms of silence, sounds never play
+void InitAudioDevice (void) {
+  audioReady = true;
+}
+void CloseAudioDevice (void) {
+  audioReady = false;
+}
+bool IsAudioDeviceReady (void) {
+  return audioReady;
+}
+Wave LoadWaveFromMemory (const char*, const unsigned char*, int dataSize) {
+  return dataSize > 0 ? silentWave (2400, 48000, 16, 1) : Wave{};
+}
+void WaveFormat (Wave* wave, int sampleRate, int sampleSize, int channels) {
+  const unsigned int frameCount = static_cast<unsigned int> (
+      static_cast<std::uint64_t> (wave->frameCount) * sampleRate / wave->sampleRate);
+  std::free (wave->data);
+  *wave = silentWave (frameCount, static_cast<unsigned int> (sampleRate),
+                      static_cast<unsigned int> (sampleSize), static_cast<unsigned int> (channels));
+}
+void UnloadWave (Wave wave) {
+  std::free (wave.data);
+}
+Sound LoadSoundFromWave (Wave wave) {
+  Sound sound{};
+  sound.stream.sampleRate = wave.sampleRate;
+  sound.stream.sampleSize = wave.sampleSize;
+  sound.stream.channels = wave.channels;
+  sound.frameCount = wave.frameCount;
+  return sound;
+}
+void UnloadSound (Sound) {
+}
+void PlaySound (Sound) {
+  sounds++;
+}
+bool IsSoundPlaying (Sound) {
+  return false;
+}
+AudioStream LoadAudioStream (unsigned int sampleRate, unsigned int sampleSize,
+                             unsigned int channels) {
+  AudioStream stream{};
+  stream.sampleRate = sampleRate;
+  stream.sampleSize = sampleSize;
+  stream.channels = channels;
+  return stream;
+}
+void UnloadAudioStream (AudioStream) {
+}
+void SetAudioStreamCallback (AudioStream, AudioCallback) {
+}
+void PlayAudioStream (AudioStream) {
+}
+void StopAudioStream (AudioStream) {
+}
+
+} // extern "C"
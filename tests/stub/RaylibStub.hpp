@@ -0,0 +1,26 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// raylib without window, GPU or audio device, linked into the tests in place of the real one
+
+#ifndef RAYLIBSTUB_HPP
+#define RAYLIBSTUB_HPP
+
+#include <cstdint>
+
+// The raylib functions the engine calls are defined by RaylibStub.cpp: drawing does nothing,
+// the window has the size it was opened with, sounds are silent and EndDrawing () waits for
+// the SetTargetFPS () rate like raylib does. The keyboard is scripted from here.
+namespace RaylibStub {
+
+  // Held keys as IsKeyDown () reports them
+  void setKeyDown (int key, bool down);
+  // Queues a press for GetKeyPressed (), like a key tapped between two frames
+  void pressKey (int key);
+  void releaseKeys ();
+
+  std::uint64_t framesDrawn ();
+  std::uint64_t soundsPlayed ();
+
+} // namespace RaylibStub
+
+#endif // RAYLIBSTUB_HPP